@@ -0,0 +1,251 @@
+#include "Application/Application.h"
+#include "Application/GlobalSettings.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
+#include "Utilities/Logger.h"
+
+#include "BenchmarkResults.h"
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+// Renders a fixed number of frames along a scripted camera path and writes the frame times, percentiles
+// and render statistics. Every option the engine knows is passed on, e.g. --headless or --stress-entities.
+//   --frames <n>         Frames that are measured, 1000 by default
+//   --warmup <n>         Frames rendered at the start of the path before measuring, 100 by default
+//   --path <file>        Camera keys in the batch view format, an orbit around the scene by default
+//   --results <file>     benchmark.csv by default, a .json extension writes JSON instead
+//   --baseline <file>    Results of an earlier run to compare against, exits with 1 if any regressed
+//   --tolerance <n>      Percentage a metric may grow by before it counts as a regression, 5 by default
+struct BenchmarkOptions {
+    uint32_t frames = 1000;
+    uint32_t warmupFrames = 100;
+    std::string pathFile;
+    std::string resultsFile = "benchmark.csv";
+    std::string baselineFile;
+    double tolerance = 0.05;
+};
+
+// Takes the benchmark's own options out of the arguments, the rest are left for the engine
+BenchmarkOptions parseBenchmarkOptions(std::vector<std::string>& arguments) {
+    BenchmarkOptions options;
+    std::vector<std::string> remaining;
+    for (size_t i = 0; i < arguments.size(); i++) {
+        const auto& argument = arguments[i];
+        auto value = [&]() -> const std::string& {
+            if (i + 1 >= arguments.size()) {
+                throw std::invalid_argument("Command line option " + argument + " expects a value");
+            }
+            return arguments[++i];
+        };
+        auto number = [&]() -> double {
+            const auto& text = value();
+            size_t parsed = 0;
+            double result = 0.0;
+            try {
+                result = std::stod(text, &parsed);
+            } catch (const std::exception&) {
+            }
+            if (parsed == 0 || parsed != text.size() || result < 0.0) {
+                throw std::invalid_argument("Command line option " + argument + " expects a number, got '" + text + "'");
+            }
+            return result;
+        };
+
+        if (argument == "--frames") {
+            options.frames = std::max(static_cast<uint32_t>(number()), 1u);
+        } else if (argument == "--warmup") {
+            options.warmupFrames = static_cast<uint32_t>(number());
+        } else if (argument == "--path") {
+            options.pathFile = value();
+        } else if (argument == "--results") {
+            options.resultsFile = value();
+        } else if (argument == "--baseline") {
+            options.baselineFile = value();
+        } else if (argument == "--tolerance") {
+            options.tolerance = number() / 100.0;
+        } else {
+            remaining.push_back(argument);
+        }
+    }
+
+    remaining.push_back("--frames");
+    remaining.push_back(std::to_string(options.warmupFrames + options.frames));
+    arguments = remaining;
+    return options;
+}
+
+class Benchmark : public Yare::Application {
+public:
+    explicit Benchmark(const BenchmarkOptions& options)
+        : m_Options(options), m_Measurements(options.frames) {
+        // Frames are rendered as fast as the present mode allows
+        for (auto& pacing : Yare::GlobalSettings::instance()->framePacing) {
+            pacing.targetFrameTimeMs = 0.0f;
+        }
+    }
+
+    ~Benchmark() override = default;
+
+    // Writes the results and compares them to the baseline, returns the exit code of the process
+    int report() {
+        auto results = collectResults();
+        if (Yare::writeBenchmarkResults(m_Options.resultsFile, results)) {
+            YZ_INFO("Wrote the benchmark results to " + m_Options.resultsFile);
+        } else {
+            YZ_ERROR("Could not write the benchmark results to " + m_Options.resultsFile);
+            return 2;
+        }
+
+        if (m_Options.baselineFile.empty()) {
+            return 0;
+        }
+        Yare::BenchmarkResults baseline;
+        if (!Yare::readBenchmarkResults(m_Options.baselineFile, baseline)) {
+            YZ_ERROR("Could not read the baseline " + m_Options.baselineFile);
+            return 2;
+        }
+        auto regressions = Yare::compareBenchmarkResults(results, baseline, m_Options.tolerance);
+        if (regressions > 0) {
+            YZ_ERROR(STR(regressions) + " metrics regressed against " + m_Options.baselineFile);
+            return 1;
+        }
+        YZ_INFO("No regressions against " + m_Options.baselineFile);
+        return 0;
+    }
+
+protected:
+    void onBeginFrame(uint32_t frameIndex) override {
+        if (!m_Path) {
+            m_Path = createPath();
+        }
+        // Warm up frames look from the start of the path
+        float t = 0.0f;
+        if (frameIndex >= m_Options.warmupFrames && m_Options.frames > 1) {
+            t = static_cast<float>(frameIndex - m_Options.warmupFrames) / static_cast<float>(m_Options.frames - 1);
+        }
+        setView(m_Path->evaluate(t));
+        m_FrameStart = Clock::now();
+    }
+
+    void onEndFrame(uint32_t frameIndex) override {
+        auto frameEnd = Clock::now();
+        const auto& gpuProfiler = Yare::Graphics::VulkanContext::getContext()->getGpuProfiler();
+        bool gpuCollected = gpuProfiler->getCollectedFrames() != m_GpuFrames;
+        m_GpuFrames = gpuProfiler->getCollectedFrames();
+
+        if (frameIndex >= m_Options.warmupFrames) {
+            m_Measurements.record(Yare::FrameMetric::CpuTime, milliseconds(frameEnd - m_FrameStart));
+            if (m_PreviousFrameEnd) {
+                m_Measurements.record(Yare::FrameMetric::PresentInterval, milliseconds(frameEnd - *m_PreviousFrameEnd));
+            }
+            if (gpuCollected) {
+                m_Measurements.record(Yare::FrameMetric::GpuTime, gpuProfiler->getFrameMilliseconds());
+            }
+            // Counted while the previous frame was recorded, the same work as this one's
+            const auto& counters = Yare::Graphics::RenderStatistics::instance()->getLastFrame();
+            for (int i = 0; i < static_cast<int>(Yare::Graphics::RenderCounter::Count); i++) {
+                m_CounterTotals[i] += counters.values[i];
+            }
+            m_MeasuredFrames++;
+        }
+        m_PreviousFrameEnd = frameEnd;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static double milliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    Yare::CameraPath createPath() const {
+        if (!m_Options.pathFile.empty()) {
+            return Yare::CameraPath(Yare::loadBatchViews(m_Options.pathFile));
+        }
+        // Keeps the whole stress scene in view, or circles the regular one
+        float radius = 8.0f;
+        auto entityCount = getLaunchOptions().stressScene.entityCount;
+        if (entityCount > 0) {
+            auto side = std::ceil(std::sqrt(static_cast<float>(entityCount)));
+            radius = std::max(radius, side * Yare::Graphics::STRESS_SCENE_SPACING * 0.75f);
+        }
+        return Yare::CameraPath::createOrbit(radius, radius * 0.35f + 1.0f);
+    }
+
+    Yare::BenchmarkResults collectResults() const {
+        const auto& launchOptions = getLaunchOptions();
+        const auto& scene = launchOptions.stressScene;
+        Yare::BenchmarkResults results = {
+            {"frames", static_cast<double>(m_Options.frames), true},
+            {"warmup", static_cast<double>(m_Options.warmupFrames), true},
+            {"width", static_cast<double>(launchOptions.width), true},
+            {"height", static_cast<double>(launchOptions.height), true},
+            {"headless", launchOptions.headless ? 1.0 : 0.0, true},
+            {"entities", static_cast<double>(scene.entityCount), true},
+            {"meshes", static_cast<double>(scene.meshCount), true},
+            {"textures", static_cast<double>(scene.textureCount), true},
+            {"terrain_size", static_cast<double>(scene.terrainSize), true},
+            {"seed", static_cast<double>(scene.seed), true},
+        };
+
+        const char* names[] = {"cpu", "gpu", "frame"};
+        for (int i = 0; i < static_cast<int>(Yare::FrameMetric::Count); i++) {
+            auto summary = m_Measurements.getSummary(static_cast<Yare::FrameMetric>(i));
+            if (summary.samples == 0) {
+                continue;
+            }
+            std::string name = names[i];
+            results.push_back({name + "_avg_ms", summary.average});
+            results.push_back({name + "_p50_ms", summary.p50});
+            results.push_back({name + "_p95_ms", summary.p95});
+            results.push_back({name + "_p99_ms", summary.p99});
+            results.push_back({name + "_max_ms", summary.max});
+        }
+        results.push_back({"stutters", static_cast<double>(m_Measurements.getStutterCount())});
+
+        // Averages per frame, e.g. draw_calls
+        for (int i = 0; i < static_cast<int>(Yare::Graphics::RenderCounter::Count); i++) {
+            std::string name = Yare::Graphics::getRenderCounterName(static_cast<Yare::Graphics::RenderCounter>(i));
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](char c) { return c == ' ' ? '_' : static_cast<char>(std::tolower(c)); });
+            results.push_back({name, static_cast<double>(m_CounterTotals[i]) / std::max<uint64_t>(m_MeasuredFrames, 1)});
+        }
+        return results;
+    }
+
+private:
+    BenchmarkOptions                m_Options;
+    std::optional<Yare::CameraPath> m_Path;
+    Yare::FrameStatistics           m_Measurements;
+
+    Clock::time_point               m_FrameStart;
+    std::optional<Clock::time_point> m_PreviousFrameEnd;
+    uint64_t                        m_GpuFrames = 0;
+    uint64_t                        m_CounterTotals[static_cast<int>(Yare::Graphics::RenderCounter::Count)] = {};
+    uint64_t                        m_MeasuredFrames = 0;
+};
+
+int main(int argc, char** argv) {
+    std::vector<std::string> arguments(argv + std::min(argc, 1), argv + argc);
+    BenchmarkOptions options;
+    try {
+        options = parseBenchmarkOptions(arguments);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    auto benchmark = new Benchmark(options);
+    benchmark->setArguments(arguments);
+    benchmark->run();
+    auto exitCode = benchmark->report();
+    delete benchmark;
+    return exitCode;
+}
@@ -0,0 +1,160 @@
+#include "BenchmarkResults.h"
+#include "Utilities/Logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Yare {
+
+    namespace {
+        bool isJson(const std::string& filePath) {
+            return filePath.size() >= 5 && filePath.compare(filePath.size() - 5, 5, ".json") == 0;
+        }
+
+        bool parseNumber(const std::string& text, double& value) {
+            std::istringstream stream(text);
+            stream >> value;
+            return !stream.fail();
+        }
+
+        const BenchmarkMetric* findMetric(const BenchmarkResults& results, const std::string& name) {
+            auto it = std::find_if(results.begin(), results.end(),
+                                   [&](const BenchmarkMetric& metric) { return metric.name == name; });
+            return it != results.end() ? &*it : nullptr;
+        }
+
+        void writeJsonSection(std::ofstream& file, const BenchmarkResults& results, bool parameters) {
+            file << "  \"" << (parameters ? "parameters" : "metrics") << "\": {";
+            bool first = true;
+            for (const auto& metric : results) {
+                if (metric.parameter == parameters) {
+                    file << (first ? "\n" : ",\n") << "    \"" << metric.name << "\": " << metric.value;
+                    first = false;
+                }
+            }
+            file << "\n  }";
+        }
+
+        // Only reads back what writeJsonSection wrote, one value per line
+        bool readJson(std::ifstream& file, BenchmarkResults& results) {
+            bool parameters = false;
+            std::string line;
+            while (std::getline(file, line)) {
+                auto nameBegin = line.find('"');
+                if (nameBegin == std::string::npos) {
+                    continue;
+                }
+                auto nameEnd = line.find('"', nameBegin + 1);
+                auto colon = line.find(':', nameEnd);
+                if (nameEnd == std::string::npos || colon == std::string::npos) {
+                    return false;
+                }
+                auto name = line.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+                auto valueText = line.substr(colon + 1);
+                if (valueText.find('{') != std::string::npos) {
+                    parameters = name == "parameters";
+                    continue;
+                }
+
+                BenchmarkMetric metric{name, 0.0, parameters};
+                valueText.erase(std::remove(valueText.begin(), valueText.end(), ','), valueText.end());
+                if (!parseNumber(valueText, metric.value)) {
+                    return false;
+                }
+                results.push_back(metric);
+            }
+            return true;
+        }
+
+        bool readCsv(std::ifstream& file, BenchmarkResults& results) {
+            std::string line;
+            bool header = true;
+            while (std::getline(file, line)) {
+                if (header || line.empty()) {
+                    header = false;
+                    continue;
+                }
+                std::istringstream stream(line);
+                std::string name, value, kind;
+                if (!std::getline(stream, name, ',') || !std::getline(stream, value, ',') ||
+                    !std::getline(stream, kind)) {
+                    return false;
+                }
+                BenchmarkMetric metric{name, 0.0, kind.rfind("parameter", 0) == 0};
+                if (!parseNumber(value, metric.value)) {
+                    return false;
+                }
+                results.push_back(metric);
+            }
+            return true;
+        }
+    }
+
+    bool writeBenchmarkResults(const std::string& filePath, const BenchmarkResults& results) {
+        std::ofstream file(filePath);
+        if (!file) {
+            return false;
+        }
+        file << std::setprecision(10);
+
+        if (isJson(filePath)) {
+            file << "{\n";
+            writeJsonSection(file, results, true);
+            file << ",\n";
+            writeJsonSection(file, results, false);
+            file << "\n}\n";
+        } else {
+            file << "name,value,kind\n";
+            for (const auto& metric : results) {
+                file << metric.name << "," << metric.value << "," << (metric.parameter ? "parameter" : "metric") << "\n";
+            }
+        }
+        return static_cast<bool>(file);
+    }
+
+    bool readBenchmarkResults(const std::string& filePath, BenchmarkResults& results) {
+        std::ifstream file(filePath);
+        if (!file) {
+            return false;
+        }
+        results.clear();
+        return isJson(filePath) ? readJson(file, results) : readCsv(file, results);
+    }
+
+    uint32_t compareBenchmarkResults(const BenchmarkResults& results, const BenchmarkResults& baseline,
+                                     double tolerance) {
+        uint32_t regressions = 0;
+        for (const auto& metric : results) {
+            auto base = findMetric(baseline, metric.name);
+            if (base == nullptr) {
+                YZ_INFO(metric.name + " is not in the baseline");
+                continue;
+            }
+
+            if (metric.parameter) {
+                if (metric.value != base->value) {
+                    YZ_ERROR(metric.name + " is " + STR(metric.value) + " but was " + STR(base->value) +
+                             " in the baseline, the runs can't be compared");
+                    regressions++;
+                }
+                continue;
+            }
+
+            double change = base->value != 0.0 ? (metric.value - base->value) / base->value
+                                               : (metric.value > 0.0 ? 1.0 : 0.0);
+            std::ostringstream line;
+            line << std::left << std::setw(28) << metric.name << std::right << std::fixed << std::setprecision(3)
+                 << std::setw(14) << metric.value << std::setw(14) << base->value
+                 << std::showpos << std::setw(10) << change * 100.0 << "%";
+            if (change > tolerance) {
+                YZ_WARN(line.str() + "  REGRESSION");
+                regressions++;
+            } else {
+                YZ_INFO(line.str());
+            }
+        }
+        return regressions;
+    }
+}
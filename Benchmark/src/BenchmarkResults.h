@@ -0,0 +1,32 @@
+#ifndef YARE_BENCHMARK_RESULTS_H
+#define YARE_BENCHMARK_RESULTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Yare {
+
+    struct BenchmarkMetric {
+        std::string name;
+        double value = 0.0;
+        // Describes the run, e.g. the frame count or scene size, rather than measuring it
+        bool parameter = false;
+    };
+
+    using BenchmarkResults = std::vector<BenchmarkMetric>;
+
+    // Files ending in .json are written as {"parameters": {...}, "metrics": {...}}, anything else as
+    // CSV with the columns name, value, kind
+    bool writeBenchmarkResults(const std::string& filePath, const BenchmarkResults& results);
+    // Reads either format written above, false if the file is missing or malformed
+    bool readBenchmarkResults(const std::string& filePath, BenchmarkResults& results);
+
+    // Logs every metric next to its baseline and returns how many regressed. Lower is better for every
+    // metric, one regresses when it grew by more than tolerance, a fraction of the baseline.
+    // Parameters have to match exactly, a baseline of another scene says nothing about this one.
+    uint32_t compareBenchmarkResults(const BenchmarkResults& results, const BenchmarkResults& baseline,
+                                     double tolerance);
+}
+
+#endif // YARE_BENCHMARK_RESULTS_H
@@ -0,0 +1,40 @@
+#include "CameraPath.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Yare {
+
+    CameraPath::CameraPath(std::vector<BatchView> keys) : m_Keys(std::move(keys)) {
+        if (m_Keys.empty()) {
+            throw std::invalid_argument("A camera path needs at least one key");
+        }
+    }
+
+    CameraPath CameraPath::createOrbit(float radius, float height, uint32_t keyCount) {
+        std::vector<BatchView> keys(std::max(keyCount, 2u) + 1);
+        for (size_t i = 0; i < keys.size(); i++) {
+            // The last key closes the loop on the first
+            float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(keys.size() - 1);
+            keys[i].position = glm::vec3(std::cos(angle) * radius, height, std::sin(angle) * radius);
+            keys[i].target = glm::vec3(0.0f);
+        }
+        return CameraPath(std::move(keys));
+    }
+
+    BatchView CameraPath::evaluate(float t) const {
+        auto position = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(m_Keys.size() - 1);
+        auto index = std::min(static_cast<size_t>(position), m_Keys.size() - 1);
+        auto next = std::min(index + 1, m_Keys.size() - 1);
+        auto fraction = position - static_cast<float>(index);
+
+        auto view = m_Keys[index];
+        view.position = glm::mix(m_Keys[index].position, m_Keys[next].position, fraction);
+        view.target = glm::mix(m_Keys[index].target, m_Keys[next].target, fraction);
+        view.fov = glm::mix(m_Keys[index].fov, m_Keys[next].fov, fraction);
+        return view;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef YARE_CAMERA_PATH_H
+#define YARE_CAMERA_PATH_H
+
+#include "Application/BatchViews.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Yare {
+
+    // Camera keys passed at an even pace, the poses in between are interpolated linearly.
+    // Keys are batch views, so a path can be loaded with loadBatchViews.
+    class CameraPath {
+    public:
+        explicit CameraPath(std::vector<BatchView> keys);
+
+        // Circles the origin once, looking at it
+        static CameraPath createOrbit(float radius, float height, uint32_t keyCount = 64);
+
+        // t goes from 0 at the first key to 1 at the last. Which parts of the scene are shown
+        // follows the key that was passed last.
+        BatchView evaluate(float t) const;
+
+    private:
+        std::vector<BatchView> m_Keys;
+    };
+}
+
+#endif // YARE_CAMERA_PATH_H
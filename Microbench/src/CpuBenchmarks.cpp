@@ -0,0 +1,94 @@
+#include "Microbench.h"
+#include "Graphics/Components/Transform.h"
+#include "Graphics/MeshFactory.h"
+#include "Utilities/IOHelper.h"
+#include "Utilities/Logger.h"
+
+#include <stb/stb_image.h>
+
+#include <fstream>
+
+namespace Yare::Microbench {
+
+    namespace {
+        const std::string MODEL_PATH = "../Res/Models/viking_room.obj";
+        const std::string TEXTURE_PATH = "../Res/Textures/viking_room.png";
+
+        uint64_t getFileSize(const std::string& filePath) {
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            return file ? static_cast<uint64_t>(file.tellg()) : 0;
+        }
+
+        // updateMatrix is private, every setter recomputes the matrix through it
+        void benchmarkTransform(Runner& runner) {
+            Transform transform;
+            glm::quat rotations[] = {glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)),
+                                     glm::angleAxis(1.0f, glm::vec3(1.0f, 0.0f, 0.0f))};
+            uint32_t i = 0;
+            runner.measure("Transform::updateMatrix", [&]() {
+                transform.setRotation(rotations[i++ & 1]);
+                keep(transform.getMatrix());
+            });
+        }
+
+        void benchmarkLoadMesh(Runner& runner) {
+            if (!runner.isSelected("Utilities::loadMesh")) {
+                return;
+            }
+            auto fileSize = getFileSize(MODEL_PATH);
+            if (fileSize == 0) {
+                YZ_WARN("Skipped Utilities::loadMesh, " + MODEL_PATH + " is missing");
+                return;
+            }
+            std::vector<Vertex> vertices;
+            std::vector<uint32_t> indices;
+            runner.measure("Utilities::loadMesh " + MODEL_PATH, [&]() {
+                // Fresh vectors, the way Mesh loads a model
+                vertices.clear();
+                vertices.shrink_to_fit();
+                indices.clear();
+                indices.shrink_to_fit();
+                Utilities::loadMesh(MODEL_PATH, vertices, indices);
+                keep(indices.data());
+            }, fileSize);
+        }
+
+        void benchmarkQuadPlane(Runner& runner) {
+            const size_t size = 256;
+            std::vector<Vertex> vertices;
+            std::vector<uint32_t> indices;
+            // Every quad has its own six vertices and indices
+            uint64_t bytes = (size - 1) * (size - 1) * 6 * (sizeof(Vertex) + sizeof(uint32_t));
+            runner.measure("Graphics::generateQuadPlane 256x256", [&]() {
+                vertices.clear();
+                indices.clear();
+                Graphics::generateQuadPlane(size, size, vertices, indices);
+                keep(indices.data());
+            }, bytes);
+        }
+
+        void benchmarkImageDecode(Runner& runner) {
+            if (!runner.isSelected("stbi_load")) {
+                return;
+            }
+            int width = 0, height = 0, channels = 0;
+            if (!stbi_info(TEXTURE_PATH.c_str(), &width, &height, &channels)) {
+                YZ_WARN("Skipped stbi_load, " + TEXTURE_PATH + " is missing");
+                return;
+            }
+            runner.measure("stbi_load " + TEXTURE_PATH, [&]() {
+                int w, h, c;
+                stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &w, &h, &c, STBI_rgb_alpha);
+                keep(pixels);
+                stbi_image_free(pixels);
+            }, static_cast<uint64_t>(width) * height * 4);
+        }
+    }
+
+    void runCpuBenchmarks(Runner& runner) {
+        benchmarkTransform(runner);
+        benchmarkLoadMesh(runner);
+        benchmarkQuadPlane(runner);
+        benchmarkImageDecode(runner);
+    }
+}
@@ -0,0 +1,152 @@
+#include "Microbench.h"
+#include "Utilities/Logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+// Times isolated engine hot paths and counts the heap allocations each call makes.
+//   --filter <text>      Only run benchmarks whose name contains text
+//   --min-time <s>       Seconds each benchmark runs for at least, 0.5 by default
+//   --csv <file>         Also write the results as CSV
+//   --no-vulkan          Skip the benchmarks that need a Vulkan device
+// On a machine without a GPU, point VK_ICD_FILENAMES at lavapipe's ICD to run the Vulkan benchmarks.
+
+namespace {
+    // Trivially initialized, so they are usable before any constructor has run
+    thread_local uint64_t s_AllocationCount = 0;
+    thread_local uint64_t s_AllocatedBytes = 0;
+
+    void* allocate(std::size_t size) {
+        s_AllocationCount++;
+        s_AllocatedBytes += size;
+        if (void* memory = std::malloc(size ? size : 1)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        s_AllocationCount++;
+        s_AllocatedBytes += size;
+        auto align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+        void* memory = _aligned_malloc(size ? size : 1, align);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        void* memory = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (memory) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void freeAligned(void* memory) {
+#if defined(_MSC_VER)
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+// The array and nothrow forms forward to these
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void operator delete(void* memory, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { freeAligned(memory); }
+
+namespace Yare::Microbench {
+
+    uint64_t getAllocationCount() {
+        return s_AllocationCount;
+    }
+
+    uint64_t getAllocatedBytes() {
+        return s_AllocatedBytes;
+    }
+
+    Runner::Runner(double minSeconds, const std::string& filter) : m_MinSeconds(minSeconds), m_Filter(filter) {
+    }
+
+    void Runner::report(const Result& result) {
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-48s %12.1f ns/op %10.1f MB/s %8.2f allocs/op %10.0f B/op",
+                      result.name.c_str(), result.getNanosecondsPerOperation(),
+                      result.bytesPerOperation ? result.getMegabytesPerSecond() : 0.0,
+                      result.allocationsPerOperation, result.allocatedBytesPerOperation);
+        YZ_INFO(line);
+        m_Results.push_back(result);
+    }
+
+    bool Runner::writeCsv(const std::string& filePath) const {
+        std::ofstream file(filePath);
+        if (!file) {
+            return false;
+        }
+        file << "name,operations,ns_per_op,mb_per_s,allocs_per_op,alloc_bytes_per_op\n";
+        for (const auto& result : m_Results) {
+            file << result.name << "," << result.operations << "," << result.getNanosecondsPerOperation() << ","
+                 << (result.bytesPerOperation ? result.getMegabytesPerSecond() : 0.0) << ","
+                 << result.allocationsPerOperation << "," << result.allocatedBytesPerOperation << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char** argv) {
+    double minSeconds = 0.5;
+    std::string filter;
+    std::string csvFile;
+    bool vulkan = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if ((argument == "--filter" || argument == "--min-time" || argument == "--csv") && i + 1 >= argc) {
+            std::cerr << "Command line option " << argument << " expects a value" << std::endl;
+            return 2;
+        }
+        if (argument == "--filter") {
+            filter = argv[++i];
+        } else if (argument == "--min-time") {
+            minSeconds = std::atof(argv[++i]);
+        } else if (argument == "--csv") {
+            csvFile = argv[++i];
+        } else if (argument == "--no-vulkan") {
+            vulkan = false;
+        } else {
+            std::cerr << "Unknown command line option '" << argument << "'" << std::endl;
+            return 2;
+        }
+    }
+
+    Yare::Logger::init();
+    Yare::Microbench::Runner runner(minSeconds, filter);
+    Yare::Microbench::runCpuBenchmarks(runner);
+    if (vulkan) {
+        try {
+            Yare::Microbench::runVulkanBenchmarks(runner);
+        } catch (const std::exception& e) {
+            YZ_WARN(std::string("Skipped the Vulkan benchmarks: ") + e.what());
+        }
+    }
+
+    if (!csvFile.empty() && !runner.writeCsv(csvFile)) {
+        YZ_ERROR("Could not write the results to " + csvFile);
+        return 1;
+    }
+    return 0;
+}
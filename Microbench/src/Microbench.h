@@ -0,0 +1,95 @@
+#ifndef YARE_MICROBENCH_H
+#define YARE_MICROBENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Yare::Microbench {
+
+    // Heap allocations made by the calling thread so far, counted by the replaced global operator new.
+    // Background threads, e.g. the pipeline compiler, don't disturb the thread being measured.
+    uint64_t getAllocationCount();
+    uint64_t getAllocatedBytes();
+
+    // Keeps the compiler from optimizing away a result that is never used
+    template <class T>
+    inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        uint64_t    operations = 0;
+        double      seconds = 0.0;
+        double      allocationsPerOperation = 0.0;
+        double      allocatedBytesPerOperation = 0.0;
+        // 0 for benchmarks that don't process a meaningful amount of data
+        uint64_t    bytesPerOperation = 0;
+
+        double getNanosecondsPerOperation() const { return seconds * 1e9 / operations; }
+        double getMegabytesPerSecond()      const { return bytesPerOperation * operations / seconds / 1e6; }
+    };
+
+    class Runner {
+    public:
+        // Only benchmarks whose name contains filter are run
+        Runner(double minSeconds, const std::string& filter);
+
+        // Calls operation in growing batches until minSeconds have passed, the clock is only read between
+        // batches. One call before measuring warms caches and lets lazily allocated state settle.
+        // bytesPerOperation adds a throughput in MB/s.
+        template <class Operation>
+        void measure(const std::string& name, Operation&& operation, uint64_t bytesPerOperation = 0) {
+            if (!isSelected(name)) {
+                return;
+            }
+            operation();
+
+            Result result;
+            result.name = name;
+            result.bytesPerOperation = bytesPerOperation;
+            auto allocations = getAllocationCount();
+            auto allocatedBytes = getAllocatedBytes();
+            auto start = Clock::now();
+            for (uint64_t batch = 1; result.seconds < m_MinSeconds; batch *= 2) {
+                for (uint64_t i = 0; i < batch; i++) {
+                    operation();
+                }
+                result.operations += batch;
+                result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            }
+            result.allocationsPerOperation = static_cast<double>(getAllocationCount() - allocations) / result.operations;
+            result.allocatedBytesPerOperation = static_cast<double>(getAllocatedBytes() - allocatedBytes) / result.operations;
+            report(result);
+        }
+
+        bool isSelected(const std::string& name) const { return name.find(m_Filter) != std::string::npos; }
+        const std::vector<Result>& getResults() const { return m_Results; }
+        // Columns name, operations, ns_per_op, mb_per_s, allocs_per_op, alloc_bytes_per_op
+        bool writeCsv(const std::string& filePath) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void report(const Result& result);
+
+    private:
+        double              m_MinSeconds;
+        std::string         m_Filter;
+        std::vector<Result> m_Results;
+    };
+
+    // Need nothing but the CPU and the resources
+    void runCpuBenchmarks(Runner& runner);
+    // Create a headless Vulkan context, any device will do, e.g. lavapipe on a machine without a GPU
+    void runVulkanBenchmarks(Runner& runner);
+}
+
+#endif // YARE_MICROBENCH_H
@@ -0,0 +1,100 @@
+#include "Microbench.h"
+#include "Graphics/Vulkan/Buffer.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/DescriptorSet.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Image.h"
+#include "Graphics/Vulkan/Renderpass.h"
+#include "Graphics/Vulkan/Shader.h"
+#include "Core/DataStructures.h"
+
+#include <memory>
+
+namespace Yare::Microbench {
+
+    namespace {
+        void benchmarkBuffers(Runner& runner) {
+            // The size of a large uniform block, e.g. all light data of a frame
+            const size_t uniformSize = 64 * 1024;
+            std::vector<uint8_t> data(uniformSize, 0x5a);
+            Graphics::Buffer uniformBuffer(Graphics::BufferUsage::UNIFORM, uniformSize, nullptr);
+            runner.measure("Buffer::setData 64 KiB", [&]() {
+                uniformBuffer.setData(uniformSize, data.data());
+            }, uniformSize);
+
+            // One object's slot in a dynamic uniform buffer, the way the renderers write them
+            const size_t slotSize = 256;
+            const size_t slotCount = 64;
+            Graphics::Buffer dynamicBuffer(Graphics::BufferUsage::DYNAMIC, slotSize * slotCount, nullptr);
+            size_t slot = 0;
+            runner.measure("Buffer::setDynamicData 256 B", [&]() {
+                dynamicBuffer.setDynamicData(slotSize, data.data(), (slot++ % slotCount) * slotSize);
+            }, slotSize);
+        }
+
+        void benchmarkDescriptorSet(Runner& runner) {
+            if (!runner.isSelected("DescriptorSet::update")) {
+                return;
+            }
+            Graphics::RenderPass renderPass({VK_FORMAT_R8G8B8A8_UNORM, {64, 64}, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL});
+
+            // The skybox pipeline, with a descriptor set that is written rather than pushed
+            Graphics::PipelineInfo pipelineInfo = {};
+            pipelineInfo.shaderPath = "../Res/Shaders";
+            pipelineInfo.shaderName = "skybox.shader";
+            pipelineInfo.renderpass = &renderPass;
+            pipelineInfo.cullMode = VK_CULL_MODE_FRONT_BIT;
+            pipelineInfo.depthTestEnable = VK_FALSE;
+            pipelineInfo.depthWriteEnable = VK_FALSE;
+            VkVertexInputAttributeDescription pos = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos)};
+            pipelineInfo.vertexInputAttributes = {pos};
+            pipelineInfo.bindingDescription = {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX};
+            pipelineInfo.pushDescriptors = false;
+            auto pipeline = Graphics::VulkanContext::getContext()->getPipelineRegistry()->getPipeline(pipelineInfo);
+
+            std::unique_ptr<Graphics::Image> texture(Graphics::Image::createTexture2D("../Res/Textures/default.jpg"));
+            Graphics::Buffer uniformBuffers[] = {{Graphics::BufferUsage::UNIFORM, 256, nullptr},
+                                                 {Graphics::BufferUsage::UNIFORM, 256, nullptr}};
+
+            Graphics::DescriptorSet descriptorSet;
+            descriptorSet.init({pipeline.get()});
+
+            std::vector<Graphics::BufferInfo> bufferInfos(2);
+            bufferInfos[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            bufferInfos[0].size = 256;
+            bufferInfos[0].binding = 0;
+            bufferInfos[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bufferInfos[1].binding = 1;
+            bufferInfos[1].imageSampler = texture->getSampler();
+            bufferInfos[1].imageView = texture->getImageView();
+
+            // Alternating buffers, an update with unchanged infos would skip the write
+            uint32_t i = 0;
+            runner.measure("DescriptorSet::update", [&]() {
+                bufferInfos[0].buffer = uniformBuffers[i++ & 1].getBuffer();
+                descriptorSet.update(bufferInfos);
+            });
+
+            Graphics::Devices::instance()->waitIdle();
+        }
+
+        void benchmarkShaderLoading(Runner& runner) {
+            runner.measure("Shader skybox.shader", []() {
+                Graphics::Shader shader("../Res/Shaders", "skybox.shader");
+                keep(shader.getShaderStages());
+            });
+        }
+    }
+
+    void runVulkanBenchmarks(Runner& runner) {
+        // Throws when there is no Vulkan device, the caller skips this group then
+        Graphics::VulkanContext context(64, 64, true);
+
+        benchmarkBuffers(runner);
+        benchmarkDescriptorSet(runner);
+        benchmarkShaderLoading(runner);
+
+        // Everything above is destroyed, wait for the device before the context goes
+        Graphics::Devices::instance()->waitIdle();
+    }
+}
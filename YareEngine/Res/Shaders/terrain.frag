@@ -0,0 +1,55 @@
+#version 450
+
+layout (binding = 1) uniform sampler2D pageTable;
+layout (binding = 2) uniform sampler2D tileCache;
+
+// One entry per page of every mip, the CPU clears it after reading
+layout (std430, binding = 3) buffer Feedback {
+    uint requested[];
+} feedback;
+
+layout (push_constant) uniform PushConsts {
+    vec4 terrain;
+    vec4 pageParams;
+    vec4 cacheParams;
+} pc;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+void main()
+{
+    float pagesPerSide = pc.pageParams.x;
+    float mipCount = pc.pageParams.y;
+    float tileSize = pc.cacheParams.x;
+    float border = pc.cacheParams.y;
+    float paddedTile = pc.cacheParams.z;
+    float cacheSize = pc.cacheParams.w;
+
+    vec2 uv = clamp(inUV, 0.0, 0.999999);
+
+    // Mip of the virtual texture, measured in texels of the full resolution image
+    vec2 texels = uv * pagesPerSide * tileSize;
+    vec2 dx = dFdx(texels);
+    vec2 dy = dFdy(texels);
+    float mip = clamp(floor(0.5 * log2(max(dot(dx, dx), dot(dy, dy)))), 0.0, mipCount - 1.0);
+
+    // Record the page we would like to sample
+    uint offset = 0;
+    uint pages = uint(pagesPerSide);
+    for (uint level = 0; level < uint(mip); level++) {
+        offset += pages * pages;
+        pages = max(pages >> 1, 1u);
+    }
+    uvec2 page = min(uvec2(uv * float(pages)), uvec2(pages - 1));
+    feedback.requested[offset + page.y * pages + page.x] = 1;
+
+    // The page table points at the closest resident tile, x/y = cache slot, z = mip of that tile
+    vec4 entry = textureLod(pageTable, uv, mip) * 255.0;
+    float residentPages = max(pagesPerSide / exp2(entry.b), 1.0);
+    vec2 inTile = fract(uv * residentPages);
+    vec2 cacheTexel = round(entry.rg) * paddedTile + border + inTile * tileSize;
+
+    outColor = textureLod(tileCache, cacheTexel / cacheSize, 0.0);
+}
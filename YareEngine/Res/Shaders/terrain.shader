@@ -0,0 +1,6 @@
+//SHADER:VERTEX
+terrainVert.spv
+//end
+//SHADER:FRAGMENT
+terrainFrag.spv
+//end
\ No newline at end of file
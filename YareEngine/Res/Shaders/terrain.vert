@@ -0,0 +1,28 @@
+#version 450
+
+layout (location = 0) in vec3 inPosition;
+
+layout (binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout (push_constant) uniform PushConsts {
+    vec4 terrain;
+    vec4 pageParams;
+    vec4 cacheParams;
+} pc;
+
+layout (location = 0) out vec2 outUV;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    outUV = inPosition.xz / pc.terrain.x;
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+}
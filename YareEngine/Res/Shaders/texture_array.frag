@@ -7,12 +7,18 @@ layout(location = 1) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
-layout(set = 0, binding = 2) uniform sampler2D texSampler[2];
+layout(set = 0, binding = 2) uniform sampler2D texSampler[256];
 
 layout(push_constant) uniform PER_OBJECT {
     int imgIdx;
 }pc;
 
+// Toggled by the ALPHA_TEST feature in texture_array.shader
+layout(constant_id = 0) const bool ALPHA_TEST = false;
+
 void main() {
     outColor = texture(texSampler[pc.imgIdx], fragTexCoord);
+    if (ALPHA_TEST && outColor.a < 0.5) {
+        discard;
+    }
 }
\ No newline at end of file
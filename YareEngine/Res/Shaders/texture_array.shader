@@ -3,4 +3,7 @@ texture_arrayVert.spv
 //end
 //SHADER:FRAGMENT
 texture_arrayFrag.spv
-//end
\ No newline at end of file
+//end
+//FEATURE:ALPHA_TEST
+0
+//end
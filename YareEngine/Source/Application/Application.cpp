@@ -1,8 +1,10 @@
 #include "Application/Application.h"
 #include "Application/GlobalSettings.h"
+#include "Application/SessionRecorder.h"
 #include "Utilities/Logger.h"
+#include "Utilities/Profiler.h"
 #include "Graphics/RenderManager.h"
-#include "Core/Glfw.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 
 // Define the header once here before anywhere else
 // I dont have a better place to put this for now
@@ -13,10 +15,19 @@
 
 #include <imgui/imgui.h>
 
+#include <algorithm>
+#include <chrono>
 #include <exception>
+#include <filesystem>
+#include <thread>
 
 namespace Yare {
 
+    // Seconds since an arbitrary point, GLFW's clock is not available without a window
+    static double getTime() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
     Application* Application::s_AppInstance = nullptr;
 
     Application::Application() {
@@ -27,36 +38,159 @@ namespace Yare {
         ImGui::CreateContext();
     }
 
+    void Application::setArguments(int argc, char** argv) {
+        m_Arguments.assign(argv + std::min(argc, 1), argv + argc);
+    }
+
     Application::~Application() {
         GlobalSettings::release();
+        SessionRecorder::release();
+        Graphics::RenderStatistics::release();
         ImGui::DestroyContext();
     }
 
     void Application::run() {
         Yare::Logger::init();
         YZ_INFO("Logger Initialized");
+        YZ_PROFILE_THREAD("Main");
+
+        m_LaunchOptions = parseLaunchOptions(m_Arguments);
+        if (!m_LaunchOptions.batchFile.empty()) {
+            m_BatchViews = loadBatchViews(m_LaunchOptions.batchFile);
+            m_LaunchOptions.frameCount = m_LaunchOptions.warmupFrames + static_cast<uint32_t>(m_BatchViews.size());
+        }
+        auto sessionRecorder = SessionRecorder::instance();
+        if (!m_LaunchOptions.replayFile.empty()) {
+            // The session is rendered at the size and with the scene it was recorded with
+            SessionInfo session;
+            if (!sessionRecorder->loadReplay(m_LaunchOptions.replayFile, session)) {
+                YZ_CRITICAL("Could not load the session " + m_LaunchOptions.replayFile);
+            }
+            m_LaunchOptions.width = session.width;
+            m_LaunchOptions.height = session.height;
+            m_LaunchOptions.stressScene = session.stressScene;
+            m_LaunchOptions.frameCount = sessionRecorder->getFrameCount();
+        } else if (!m_LaunchOptions.recordFile.empty()) {
+            SessionInfo session{m_LaunchOptions.width, m_LaunchOptions.height, m_LaunchOptions.stressScene};
+            if (!sessionRecorder->startRecording(m_LaunchOptions.recordFile, session)) {
+                YZ_CRITICAL("Could not record the session to " + m_LaunchOptions.recordFile);
+            }
+        }
+        bool capturing = !m_LaunchOptions.captureFrames.empty() || m_LaunchOptions.captureInterval > 0;
+        if (capturing || !m_BatchViews.empty()) {
+            std::filesystem::create_directories(m_LaunchOptions.outputDirectory);
+        }
+
+        if (m_LaunchOptions.textureBudgetMiB > 0) {
+            GlobalSettings::instance()->textureBudgetMiB = static_cast<int>(m_LaunchOptions.textureBudgetMiB);
+        }
 
         //Create a window
-        Graphics::WindowProperties props = {1600, 1200};
-        m_Window = Graphics::Window::createNewWindow(props);
+        Graphics::WindowProperties props = {m_LaunchOptions.width, m_LaunchOptions.height};
+        m_Window = m_LaunchOptions.headless ? Graphics::Window::createHeadlessWindow(props)
+                                            : Graphics::Window::createNewWindow(props);
 
-        Graphics::RenderManager renderManager{m_Window};
+        auto settings = GlobalSettings::instance();
+        Graphics::RenderManager renderManager{m_Window, settings->presentMode,
+                                              static_cast<uint32_t>(settings->getFramePacing().imageCount),
+                                              m_LaunchOptions.stressScene};
+        sessionRecorder->setEntities(renderManager.getEntities());
+        if (!m_LaunchOptions.gpuTimingsFile.empty()) {
+            Graphics::VulkanContext::getContext()->getGpuProfiler()->openCsvLog(m_LaunchOptions.gpuTimingsFile);
+        }
+        if (!m_LaunchOptions.renderStatisticsFile.empty()) {
+            Graphics::RenderStatistics::instance()->openCsvLog(m_LaunchOptions.renderStatisticsFile);
+        }
+        GlobalSettings::instance()->pipelineStatistics |= m_LaunchOptions.pipelineStatistics;
 
-        auto previousFPSTime = glfwGetTime();
-        auto previousFrameTime = glfwGetTime();
+        auto previousFPSTime = getTime();
+        auto previousFrameTime = getTime();
         int frameCount = 0;
+        uint32_t frameIndex = 0;
+
+        auto frameStartTime = getTime();
+        double batchStartTime = 0.0;
+        double previousPresentTime = 0.0;
+        uint64_t gpuFrames = 0;
+        const auto& gpuProfiler = Graphics::VulkanContext::getContext()->getGpuProfiler();
+        auto sessionStartTime = getTime();
 
         while (!m_Window->shouldClose()) {
+            YZ_PROFILE_SCOPE("Frame");
+            auto workStartTime = getTime();
+            std::string capturePath;
+            const auto& captureFrames = m_LaunchOptions.captureFrames;
+            auto interval = m_LaunchOptions.captureInterval;
+            if ((interval > 0 && frameIndex % interval == 0) ||
+                    std::find(captureFrames.begin(), captureFrames.end(), frameIndex) != captureFrames.end()) {
+                auto index = std::to_string(frameIndex);
+                index.insert(0, 6 - std::min<size_t>(index.size(), 6), '0');
+                capturePath = m_LaunchOptions.outputDirectory + "/frame_" + index + "." + m_LaunchOptions.captureFormat;
+            }
+
+            if (!m_BatchViews.empty()) {
+                // Warm up frames look through the first view
+                auto warmup = m_LaunchOptions.warmupFrames;
+                auto viewIndex = frameIndex < warmup ? 0 : frameIndex - warmup;
+                prepareBatchView(m_BatchViews[viewIndex], capturePath);
+                if (frameIndex < warmup) {
+                    capturePath.clear();
+                } else if (frameIndex == warmup) {
+                    batchStartTime = getTime();
+                }
+            }
+
+            onBeginFrame(frameIndex);
+            if (sessionRecorder->isReplaying()) {
+                sessionRecorder->replayFrame(*m_Window->getCamera());
+            } else {
+                sessionRecorder->recordFrame(*m_Window->getCamera());
+            }
+            if (!capturePath.empty()) {
+                renderManager.requestCapture(capturePath);
+            }
+            renderManager.setPresentMode(settings->presentMode, static_cast<uint32_t>(settings->getFramePacing().imageCount));
+            renderManager.setPipelineStatistics(settings->pipelineStatistics);
             renderManager.renderScene();
-            m_Window->onUpdate();
+            onEndFrame(frameIndex);
+            frameIndex++;
+
+            auto presentTime = getTime();
+            if (previousPresentTime > 0.0) {
+                m_FrameStatistics.record(FrameMetric::PresentInterval, (presentTime - previousPresentTime) * 1000.0);
+            }
+            previousPresentTime = presentTime;
+            // GPU times arrive a couple of frames late, and only once per frame that was read back
+            if (gpuProfiler->getCollectedFrames() != gpuFrames) {
+                gpuFrames = gpuProfiler->getCollectedFrames();
+                m_FrameStatistics.record(FrameMetric::GpuTime, gpuProfiler->getFrameMilliseconds());
+            }
+            if (m_LaunchOptions.frameCount > 0 && frameIndex >= m_LaunchOptions.frameCount) {
+                m_Window->close();
+            }
+
+            // Headless frames are produced as fast as possible
+            if (!m_LaunchOptions.headless) {
+                YZ_PROFILE_SCOPE("Frame limiter");
+                limitFrameRate(frameStartTime);
+            }
+            frameStartTime = getTime();
+            // Input is polled after the limiter, so the next frame sees the freshest input
+            {
+                YZ_PROFILE_SCOPE("Window::onUpdate");
+                m_Window->onUpdate();
+            }
+            // Everything but the limiter, including waiting for the GPU when it is the bottleneck
+            m_FrameStatistics.record(FrameMetric::CpuTime,
+                                     (presentTime - workStartTime + getTime() - frameStartTime) * 1000.0);
 
             // FPS
             {
-                auto currentTime = glfwGetTime();
+                auto currentTime = getTime();
                 auto deltaFPSTime = currentTime - previousFPSTime;
                 m_Window->getCamera()->setCameraSpeed((float)(currentTime - previousFrameTime) * 5);
                 if (deltaFPSTime >= 1.0) {
-                    if (GlobalSettings::instance()->logFps) YZ_INFO("FPS: " + std::to_string(frameCount));
+                    if (GlobalSettings::instance()->logFps) YZ_INFO("FPS: {}", frameCount);
                     GlobalSettings::instance()->fps = frameCount;
                     previousFPSTime = currentTime;
                     frameCount = 0;
@@ -66,5 +200,74 @@ namespace Yare {
             }
 
         }
+
+        if (!m_BatchViews.empty()) {
+            // The last views are still being written
+            auto statistics = renderManager.flushCaptures();
+            auto seconds = getTime() - batchStartTime;
+            YZ_INFO("Rendered " + STR(m_BatchViews.size()) + " views in " + STR(seconds) + " s, " +
+                    STR(statistics.captured / seconds) + " views per second, " + STR(statistics.failed) +
+                    " failed to write");
+        }
+
+        if (sessionRecorder->isReplaying()) {
+            auto seconds = getTime() - sessionStartTime;
+            auto cpu = m_FrameStatistics.getSummary(FrameMetric::CpuTime);
+            auto gpu = m_FrameStatistics.getSummary(FrameMetric::GpuTime);
+            YZ_INFO("Replayed " + STR(frameIndex) + " frames in " + STR(seconds) + " s, CPU p50 " + STR(cpu.p50) +
+                    " ms p99 " + STR(cpu.p99) + " ms, GPU p50 " + STR(gpu.p50) + " ms p99 " + STR(gpu.p99) +
+                    " ms over the last " + STR(cpu.samples) + " frames");
+        } else if (sessionRecorder->isRecording()) {
+            YZ_INFO("Recorded " + STR(sessionRecorder->getFrameCount()) + " frames to " + m_LaunchOptions.recordFile);
+        }
+        sessionRecorder->stop();
+        // The entities go with the render manager
+        sessionRecorder->setEntities({});
+
+        if (!m_LaunchOptions.cpuTraceFile.empty()) {
+#if YZ_ENABLE_PROFILING
+            if (Utilities::Profiler::writeChromeTrace(m_LaunchOptions.cpuTraceFile)) {
+                YZ_INFO("Wrote the CPU trace to " + m_LaunchOptions.cpuTraceFile);
+            } else {
+                YZ_WARN("Could not write the CPU trace to " + m_LaunchOptions.cpuTraceFile);
+            }
+#else
+            YZ_WARN("Profiling is compiled out of this build, configure with YARE_FORCE_PROFILING to record a trace");
+#endif
+        }
+    }
+
+    void Application::prepareBatchView(const BatchView& view, std::string& capturePath) {
+        setView(view);
+        capturePath = m_LaunchOptions.outputDirectory + "/" + view.name + "." + m_LaunchOptions.captureFormat;
+    }
+
+    void Application::setView(const BatchView& view) {
+        auto camera = m_Window->getCamera();
+        camera->setFov(view.fov);
+        camera->setPosition(view.position);
+        camera->setLookAt(glm::normalize(view.target - view.position));
+
+        auto settings = GlobalSettings::instance();
+        settings->displayModels = view.displayModels;
+        settings->displayBackground = view.displayBackground;
+        settings->displayTerrain = view.displayTerrain;
+    }
+
+    void Application::limitFrameRate(double frameStartTime) {
+        double targetFrameTime = GlobalSettings::instance()->getFramePacing().targetFrameTimeMs / 1000.0;
+        if (targetFrameTime <= 0.0) {
+            return;
+        }
+
+        // Sleep is only accurate to a millisecond or so, spin for the remainder
+        double wakeTime = frameStartTime + targetFrameTime;
+        double remaining = wakeTime - getTime();
+        if (remaining > 0.002) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(remaining - 0.002));
+        }
+        while (getTime() < wakeTime) {
+            std::this_thread::yield();
+        }
     }
 }
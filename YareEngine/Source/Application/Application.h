@@ -2,9 +2,14 @@
 #define YARE_APPLICATION_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "Core/Core.h"
 #include "Graphics/Window/Window.h"
+#include "Application/LaunchOptions.h"
+#include "Application/BatchViews.h"
+#include "Application/FrameStatistics.h"
 
 namespace Yare {
 
@@ -12,13 +17,38 @@ namespace Yare {
     public:
         Application();
         virtual ~Application();
+        // Command line arguments without the program name, parsed once run starts
+        void setArguments(int argc, char** argv);
+        void setArguments(const std::vector<std::string>& arguments) { m_Arguments = arguments; }
         void run();
 
         std::shared_ptr<Graphics::Window> getWindow() const { return m_Window; }
+        const LaunchOptions& getLaunchOptions() const { return m_LaunchOptions; }
+        // Frame times and stutters over the last frames
+        FrameStatistics& getFrameStatistics() { return m_FrameStatistics; }
 
         inline static Application* getAppInstance() { return s_AppInstance; }
+
+    protected:
+        // Called around the rendering of every frame, e.g. to move the camera along a scripted path.
+        // frameIndex counts from 0 and is the same for both calls.
+        virtual void onBeginFrame(uint32_t frameIndex) {}
+        virtual void onEndFrame(uint32_t frameIndex) {}
+        // Moves the camera to the view and shows the parts of the scene it lists
+        void setView(const BatchView& view);
+
+    private:
+        // Blocks until the target frame time of the current present mode has passed since frameStartTime
+        void limitFrameRate(double frameStartTime);
+        // Sets the batch view rendered this frame and names the image after it
+        void prepareBatchView(const BatchView& view, std::string& capturePath);
+
     private:
         std::shared_ptr<Graphics::Window> m_Window;
+        std::vector<std::string> m_Arguments;
+        LaunchOptions m_LaunchOptions;
+        std::vector<BatchView> m_BatchViews;
+        FrameStatistics m_FrameStatistics;
         static Application* s_AppInstance;
     };
 
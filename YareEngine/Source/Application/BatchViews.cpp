@@ -0,0 +1,100 @@
+#include "Application/BatchViews.h"
+#include "Utilities/Logger.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Yare {
+
+    namespace {
+        std::string trim(const std::string& text) {
+            auto begin = text.find_first_not_of(" \t\r");
+            if (begin == std::string::npos) {
+                return "";
+            }
+            auto end = text.find_last_not_of(" \t\r");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        std::vector<std::string> split(const std::string& text, char separator) {
+            std::vector<std::string> fields;
+            std::stringstream stream(text);
+            std::string field;
+            while (std::getline(stream, field, separator)) {
+                fields.push_back(trim(field));
+            }
+            return fields;
+        }
+    }
+
+    std::vector<BatchView> loadBatchViews(const std::string& filePath) {
+        std::ifstream file(filePath);
+        if (!file) {
+            YZ_CRITICAL("Could not open the batch file " + filePath);
+        }
+
+        std::vector<BatchView> views;
+        std::string line;
+        uint32_t lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            line = trim(line);
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            auto location = filePath + ":" + STR(lineNumber);
+            auto fields = split(line, ',');
+            if (fields[0] == "name") {
+                continue;
+            }
+            if (fields.size() < 7 || fields.size() > 9 || fields[0].empty()) {
+                YZ_CRITICAL(location + " expects name, x, y, z, targetX, targetY, targetZ[, fov[, layers]]");
+            }
+
+            auto number = [&](size_t index) {
+                try {
+                    size_t parsed = 0;
+                    auto result = std::stof(fields[index], &parsed);
+                    if (parsed == fields[index].size()) {
+                        return result;
+                    }
+                } catch (const std::exception&) {
+                }
+                YZ_CRITICAL(location + " expects a number, got '" + fields[index] + "'");
+                return 0.0f;
+            };
+
+            BatchView view;
+            view.name = fields[0];
+            view.position = glm::vec3(number(1), number(2), number(3));
+            view.target = glm::vec3(number(4), number(5), number(6));
+            if (view.position == view.target) {
+                YZ_CRITICAL(location + " looks at its own position");
+            }
+            if (fields.size() > 7 && !fields[7].empty()) {
+                view.fov = number(7);
+            }
+            if (fields.size() > 8) {
+                view.displayModels = view.displayBackground = view.displayTerrain = false;
+                for (const auto& layer : split(fields[8], '|')) {
+                    if (layer == "models") {
+                        view.displayModels = true;
+                    } else if (layer == "background") {
+                        view.displayBackground = true;
+                    } else if (layer == "terrain") {
+                        view.displayTerrain = true;
+                    } else {
+                        YZ_CRITICAL(location + " has the unknown layer '" + layer + "'");
+                    }
+                }
+            }
+            views.push_back(view);
+        }
+
+        if (views.empty()) {
+            YZ_CRITICAL("The batch file " + filePath + " has no views");
+        }
+        return views;
+    }
+}
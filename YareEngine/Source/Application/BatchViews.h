@@ -0,0 +1,31 @@
+#ifndef YARE_BATCH_VIEWS_H
+#define YARE_BATCH_VIEWS_H
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Yare {
+
+    // One image of a batch render, the camera pose and which parts of the scene are visible
+    struct BatchView {
+        // Name of the written image, without the extension
+        std::string name;
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 target = glm::vec3(0.0f, 0.0f, 1.0f);
+        float fov = 50.0f;
+        bool displayModels = true;
+        bool displayBackground = true;
+        bool displayTerrain = true;
+    };
+
+    // Reads a CSV file with a view per line
+    //   name, x, y, z, targetX, targetY, targetZ[, fov[, layers]]
+    // where layers is a '|' separated subset of models, background and terrain, all of them if left out.
+    // Empty lines, lines starting with '#' and a header line whose first field is "name" are skipped.
+    // A missing file or a malformed line is a critical error.
+    std::vector<BatchView> loadBatchViews(const std::string& filePath);
+}
+
+#endif // YARE_BATCH_VIEWS_H
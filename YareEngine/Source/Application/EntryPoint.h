@@ -3,8 +3,9 @@
 
 extern Yare::Application* Yare::createApplication();
 
-int main() {
+int main(int argc, char** argv) {
     auto app = Yare::createApplication();
+    app->setArguments(argc, argv);
     app->run();
     delete app;
 }
@@ -0,0 +1,85 @@
+#include "Application/FrameStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Yare {
+
+    namespace {
+        // Nearest rank on sorted samples
+        double percentile(const std::vector<double>& sorted, double fraction) {
+            auto rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+            return sorted[std::min(std::max(rank, static_cast<size_t>(1)), sorted.size()) - 1];
+        }
+
+        // Too few intervals give a meaningless median, nothing is flagged until then
+        const size_t MIN_STUTTER_SAMPLES = 30;
+    }
+
+    FrameStatistics::FrameStatistics(uint32_t windowSize, double stutterFactor)
+        : m_WindowSize(std::max(windowSize, 1u)), m_StutterFactor(stutterFactor) {
+        for (auto& window : m_Windows) {
+            window.samples.reserve(m_WindowSize);
+        }
+        m_Scratch.reserve(m_WindowSize);
+    }
+
+    void FrameStatistics::record(FrameMetric metric, double milliseconds) {
+        auto& window = m_Windows[static_cast<int>(metric)];
+
+        bool stutter = false;
+        if (metric == FrameMetric::PresentInterval && window.samples.size() >= MIN_STUTTER_SAMPLES) {
+            m_Scratch.assign(window.samples.begin(), window.samples.end());
+            auto middle = m_Scratch.begin() + m_Scratch.size() / 2;
+            std::nth_element(m_Scratch.begin(), middle, m_Scratch.end());
+            stutter = milliseconds > *middle * m_StutterFactor;
+            if (stutter) {
+                m_StutterCount++;
+                m_LastStutter = milliseconds;
+            }
+        }
+
+        if (window.samples.size() < m_WindowSize) {
+            window.samples.push_back(milliseconds);
+            window.stutters.push_back(stutter);
+        } else {
+            window.samples[window.next] = milliseconds;
+            window.stutters[window.next] = stutter;
+        }
+        window.next = (window.next + 1) % m_WindowSize;
+    }
+
+    void FrameStatistics::reset() {
+        for (auto& window : m_Windows) {
+            window.samples.clear();
+            window.stutters.clear();
+            window.next = 0;
+        }
+        m_StutterCount = 0;
+        m_LastStutter = 0.0;
+    }
+
+    FrameMetricSummary FrameStatistics::getSummary(FrameMetric metric) const {
+        const auto& samples = getWindow(metric).samples;
+        FrameMetricSummary summary;
+        if (samples.empty()) {
+            return summary;
+        }
+
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        summary.samples = static_cast<uint32_t>(sorted.size());
+        summary.average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+        summary.p50 = percentile(sorted, 0.50);
+        summary.p95 = percentile(sorted, 0.95);
+        summary.p99 = percentile(sorted, 0.99);
+        summary.max = sorted.back();
+        return summary;
+    }
+
+    uint32_t FrameStatistics::getWindowStutterCount() const {
+        const auto& stutters = getWindow(FrameMetric::PresentInterval).stutters;
+        return static_cast<uint32_t>(std::count(stutters.begin(), stutters.end(), true));
+    }
+}
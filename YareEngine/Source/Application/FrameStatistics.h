@@ -0,0 +1,69 @@
+#ifndef YARE_FRAME_STATISTICS_H
+#define YARE_FRAME_STATISTICS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Yare {
+
+    enum class FrameMetric {
+        CpuTime = 0,     // Work done by the CPU each frame, without the frame limiter
+        GpuTime,         // The whole frame on the GPU, as timed by the GPU profiler
+        PresentInterval, // Time between two presents, what the user sees
+        Count
+    };
+
+    // Milliseconds over the samples in the window
+    struct FrameMetricSummary {
+        uint32_t samples = 0;
+        double   average = 0.0;
+        double   p50 = 0.0;
+        double   p95 = 0.0;
+        double   p99 = 0.0;
+        double   max = 0.0;
+    };
+
+    // Keeps the last windowSize samples of every metric. A present interval longer than stutterFactor
+    // times the median interval of the window counts as a stutter.
+    class FrameStatistics {
+    public:
+        FrameStatistics(uint32_t windowSize = 1000, double stutterFactor = 2.0);
+
+        void record(FrameMetric metric, double milliseconds);
+        // Forgets every sample and stutter, e.g. once a benchmark has warmed up
+        void reset();
+
+        // Percentiles use the nearest rank, so they are always a sample that was recorded
+        FrameMetricSummary getSummary(FrameMetric metric) const;
+
+        // Stutters over the whole run and those whose interval is still in the window
+        uint64_t getStutterCount()        const { return m_StutterCount; }
+        uint32_t getWindowStutterCount()  const;
+        // The most recent stutter, 0 if there has not been one
+        double   getLastStutter()         const { return m_LastStutter; }
+        double   getStutterFactor()       const { return m_StutterFactor; }
+        void     setStutterFactor(double factor) { m_StutterFactor = factor; }
+        uint32_t getWindowSize()          const { return m_WindowSize; }
+
+    private:
+        struct Window {
+            std::vector<double> samples;
+            // Matches samples, only used for present intervals
+            std::vector<bool>   stutters;
+            uint32_t            next = 0;
+        };
+
+        const Window& getWindow(FrameMetric metric) const { return m_Windows[static_cast<int>(metric)]; }
+
+    private:
+        uint32_t m_WindowSize;
+        double   m_StutterFactor;
+        Window   m_Windows[static_cast<int>(FrameMetric::Count)];
+        uint64_t m_StutterCount = 0;
+        double   m_LastStutter = 0.0;
+        // Reused to find the median interval every frame without allocating
+        std::vector<double> m_Scratch;
+    };
+}
+
+#endif // YARE_FRAME_STATISTICS_H
@@ -2,16 +2,38 @@
 #define YARE_GLOBAL_SETTINGS_H
 
 #include "Utilities/T_Singleton.h"
+#include "Graphics/Vulkan/PresentMode.h"
 
 namespace Yare {
+
+    using Graphics::PresentMode;
+
+    struct FramePacing {
+        // Swapchain images to request, clamped to what the surface supports
+        int imageCount;
+        // The CPU waits until at least this much time has passed since the last frame, 0 disables the limiter
+        float targetFrameTimeMs;
+    };
+
     class GlobalSettings : public Utilities::T_Singleton<GlobalSettings> {
 
     public:
         GlobalSettings() {}
         bool displayModels = true;
         bool displayBackground = true;
+        bool displayTerrain = true;
         bool logFps = false;
+        // Queries what the GPU processed each frame, if the device supports it
+        bool pipelineStatistics = false;
         double fps = 0;
+        // Texture memory the streamer may keep resident, in MiB
+        int textureBudgetMiB = 256;
+
+        // Changing either of these recreates the swapchain on the next frame, see RenderManager::setPresentMode
+        PresentMode presentMode = PresentMode::Throughput;
+        FramePacing framePacing[static_cast<int>(PresentMode::Count)] = {{2, 1000.0f / 144.0f}, {3, 0.0f}, {3, 0.0f}};
+
+        const FramePacing& getFramePacing() const { return framePacing[static_cast<int>(presentMode)]; }
     };
 }
 
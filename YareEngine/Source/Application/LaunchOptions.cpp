@@ -0,0 +1,97 @@
+#include "Application/LaunchOptions.h"
+#include "Utilities/Logger.h"
+
+namespace Yare {
+
+    LaunchOptions parseLaunchOptions(const std::vector<std::string>& arguments) {
+        LaunchOptions options;
+
+        for (size_t i = 0; i < arguments.size(); i++) {
+            const auto& argument = arguments[i];
+            auto value = [&]() -> const std::string& {
+                if (i + 1 >= arguments.size()) {
+                    YZ_CRITICAL("Command line option " + argument + " expects a value");
+                }
+                return arguments[++i];
+            };
+            auto number = [&]() -> uint32_t {
+                const auto& text = value();
+                try {
+                    size_t parsed = 0;
+                    auto result = std::stoul(text, &parsed);
+                    if (parsed == text.size()) {
+                        return static_cast<uint32_t>(result);
+                    }
+                } catch (const std::exception&) {
+                }
+                YZ_CRITICAL("Command line option " + argument + " expects a number, got '" + text + "'");
+                return 0;
+            };
+
+            if (argument == "--headless") {
+                options.headless = true;
+            } else if (argument == "--width") {
+                options.width = number();
+            } else if (argument == "--height") {
+                options.height = number();
+            } else if (argument == "--frames") {
+                options.frameCount = number();
+            } else if (argument == "--capture") {
+                options.captureFrames.push_back(number());
+            } else if (argument == "--capture-every") {
+                options.captureInterval = number();
+            } else if (argument == "--capture-format") {
+                options.captureFormat = value();
+                if (options.captureFormat != "png" && options.captureFormat != "ppm" && options.captureFormat != "raw") {
+                    YZ_CRITICAL("Unknown capture format '" + options.captureFormat + "', expected png, ppm or raw");
+                }
+            } else if (argument == "--output") {
+                options.outputDirectory = value();
+            } else if (argument == "--batch") {
+                options.batchFile = value();
+                options.headless = true;
+            } else if (argument == "--warmup") {
+                options.warmupFrames = number();
+            } else if (argument == "--gpu-timings") {
+                options.gpuTimingsFile = value();
+            } else if (argument == "--cpu-trace") {
+                options.cpuTraceFile = value();
+            } else if (argument == "--render-statistics") {
+                options.renderStatisticsFile = value();
+            } else if (argument == "--texture-budget") {
+                options.textureBudgetMiB = number();
+            } else if (argument == "--pipeline-statistics") {
+                options.pipelineStatistics = true;
+            } else if (argument == "--stress-entities") {
+                options.stressScene.entityCount = number();
+            } else if (argument == "--stress-meshes") {
+                options.stressScene.meshCount = number();
+            } else if (argument == "--stress-textures") {
+                options.stressScene.textureCount = number();
+            } else if (argument == "--terrain-size") {
+                options.stressScene.terrainSize = number();
+            } else if (argument == "--seed") {
+                options.stressScene.seed = number();
+            } else if (argument == "--record") {
+                options.recordFile = value();
+            } else if (argument == "--replay") {
+                options.replayFile = value();
+                options.headless = true;
+            } else {
+                YZ_CRITICAL("Unknown command line option '" + argument + "'");
+            }
+        }
+
+        if (options.width == 0 || options.height == 0) {
+            YZ_CRITICAL("The window size must not be 0");
+        }
+        if (!options.replayFile.empty() && (!options.recordFile.empty() || !options.batchFile.empty())) {
+            YZ_CRITICAL("A replay can't be recorded or combined with a batch");
+        }
+        // Nobody is there to close a headless window
+        if (options.headless && options.frameCount == 0) {
+            options.frameCount = 1;
+        }
+        return options;
+    }
+}
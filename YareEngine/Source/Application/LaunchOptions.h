@@ -0,0 +1,63 @@
+#ifndef YARE_LAUNCH_OPTIONS_H
+#define YARE_LAUNCH_OPTIONS_H
+
+#include "Graphics/Scene/StressScene.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Yare {
+
+    // How the application was asked to run, from the command line
+    //   --headless         Render offscreen, no window, surface or display is needed
+    //   --width <n>        Size of the window or offscreen images
+    //   --height <n>
+    //   --frames <n>       Exit after n frames, headless runs default to a single frame
+    //   --capture <n>      Write frame n to the output directory, may be repeated
+    //   --capture-every <n> Write every n-th frame, e.g. to measure capture throughput
+    //   --capture-format <png|ppm|raw>
+    //   --output <dir>     Where captured frames are written, created if missing
+    //   --batch <file>     Render every view listed in the file headless, see loadBatchViews
+    //   --warmup <n>       Frames rendered before the first batch view, lets textures stream in
+    //   --gpu-timings <file> Log the GPU time of every renderer and scope as CSV
+    //   --cpu-trace <file> Write the recorded CPU zones as a Chrome trace on exit, for Perfetto
+    //   --render-statistics <file> Log the draws, binds and uploads of every frame as CSV
+    //   --texture-budget <MiB> Texture memory the streamer may keep resident, can be changed in the settings overlay
+    //   --pipeline-statistics Query what the GPU processed each frame, shown in the settings overlay
+    //   --stress-entities <n> Render a generated scene of n entities instead, see Graphics::createStressScene
+    //   --stress-meshes <n>
+    //   --stress-textures <n>
+    //   --terrain-size <n> Quads per side of the terrain
+    //   --seed <n>         Seeds the generated scene
+    //   --record <file>    Record the camera, settings and entity transforms of every frame, see SessionRecorder
+    //   --replay <file>    Render a recorded session headless and as fast as possible, with its size and scene
+    struct LaunchOptions {
+        bool headless = false;
+        uint32_t width = 1600;
+        uint32_t height = 1200;
+        // 0 renders until the window is closed
+        uint32_t frameCount = 0;
+        std::vector<uint32_t> captureFrames;
+        // 0 only captures the frames listed above
+        uint32_t captureInterval = 0;
+        std::string captureFormat = "png";
+        std::string outputDirectory = ".";
+        std::string batchFile;
+        uint32_t warmupFrames = 0;
+        std::string gpuTimingsFile;
+        std::string cpuTraceFile;
+        std::string renderStatisticsFile;
+        bool pipelineStatistics = false;
+        // 0 keeps the default budget
+        uint32_t textureBudgetMiB = 0;
+        Graphics::StressSceneInfo stressScene;
+        std::string recordFile;
+        std::string replayFile;
+    };
+
+    // Unknown or malformed arguments are critical errors
+    LaunchOptions parseLaunchOptions(const std::vector<std::string>& arguments);
+}
+
+#endif // YARE_LAUNCH_OPTIONS_H
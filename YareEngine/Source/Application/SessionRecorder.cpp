@@ -0,0 +1,231 @@
+#include "Application/SessionRecorder.h"
+#include "Utilities/Logger.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace Yare {
+
+    namespace {
+        const char SESSION_MAGIC[4] = {'Y', 'S', 'E', 'S'};
+        const uint32_t SESSION_VERSION = 1;
+
+        enum SettingsFlags : uint8_t {
+            DisplayModels = 1 << 0,
+            DisplayBackground = 1 << 1,
+            DisplayTerrain = 1 << 2,
+            LogFps = 1 << 3,
+            PipelineStatistics = 1 << 4
+        };
+
+        template <class T>
+        bool differs(const T& a, const T& b) {
+            return std::memcmp(&a, &b, sizeof(T)) != 0;
+        }
+    }
+
+    SessionRecorder::~SessionRecorder() {
+        stop();
+    }
+
+    bool SessionRecorder::startRecording(const std::string& filePath, const SessionInfo& info) {
+        stop();
+        m_Output.open(filePath, std::ios::binary | std::ios::trunc);
+        if (!m_Output) {
+            return false;
+        }
+        m_Output.write(SESSION_MAGIC, sizeof(SESSION_MAGIC));
+        write(SESSION_VERSION);
+        write(info.width);
+        write(info.height);
+        write(info.stressScene.entityCount);
+        write(info.stressScene.meshCount);
+        write(info.stressScene.textureCount);
+        write(info.stressScene.terrainSize);
+        write(info.stressScene.seed);
+        return static_cast<bool>(m_Output);
+    }
+
+    template <class T>
+    bool SessionRecorder::read(T& value) {
+        if (m_ReplayOffset + sizeof(T) > m_Replay.size()) {
+            return false;
+        }
+        std::memcpy(&value, m_Replay.data() + m_ReplayOffset, sizeof(T));
+        m_ReplayOffset += sizeof(T);
+        return true;
+    }
+
+    bool SessionRecorder::loadReplay(const std::string& filePath, SessionInfo& info) {
+        stop();
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        m_Replay.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        char magic[sizeof(SESSION_MAGIC)];
+        uint32_t version = 0;
+        if (!read(magic) || std::memcmp(magic, SESSION_MAGIC, sizeof(magic)) != 0 || !read(version) ||
+                version != SESSION_VERSION) {
+            YZ_ERROR(filePath + " is not a session recorded by this version");
+            stop();
+            return false;
+        }
+        bool valid = read(info.width) && read(info.height) && read(info.stressScene.entityCount) &&
+                     read(info.stressScene.meshCount) && read(info.stressScene.textureCount) &&
+                     read(info.stressScene.terrainSize) && read(info.stressScene.seed);
+        auto framesOffset = m_ReplayOffset;
+
+        // Walks the frames once, so a truncated recording is caught before the replay starts
+        while (valid && m_ReplayOffset < m_Replay.size()) {
+            uint8_t flags = 0;
+            read(flags);
+            if (flags & CameraChanged) {
+                valid = read(m_Camera);
+            }
+            if (valid && (flags & SettingsChanged)) {
+                valid = read(m_Settings);
+            }
+            if (valid && (flags & EntitiesChanged)) {
+                uint32_t count = 0;
+                valid = read(count) && m_ReplayOffset + count * (sizeof(uint32_t) + sizeof(EntityState)) <= m_Replay.size();
+                m_ReplayOffset += count * (sizeof(uint32_t) + sizeof(EntityState));
+            }
+            m_FrameCount += valid;
+        }
+
+        if (!valid || m_FrameCount == 0) {
+            YZ_ERROR(filePath + " is truncated or holds no frames");
+            stop();
+            return false;
+        }
+        m_ReplayOffset = framesOffset;
+        return true;
+    }
+
+    void SessionRecorder::stop() {
+        if (m_Output.is_open()) {
+            m_Output.close();
+        }
+        m_Replay.clear();
+        m_ReplayOffset = 0;
+        m_FrameCount = 0;
+        m_HasPrevious = false;
+        m_EntityStates.clear();
+    }
+
+    SessionRecorder::CameraState SessionRecorder::captureCamera(const Graphics::Camera& camera) {
+        auto transform = camera.getTransform();
+        return {transform.getTranslation(), transform.getVec3Rotation(), camera.getLookAtVector(), camera.getFov()};
+    }
+
+    SessionRecorder::SettingsState SessionRecorder::captureSettings(const GlobalSettings& settings) {
+        uint8_t flags = (settings.displayModels ? DisplayModels : 0) |
+                        (settings.displayBackground ? DisplayBackground : 0) |
+                        (settings.displayTerrain ? DisplayTerrain : 0) |
+                        (settings.logFps ? LogFps : 0) |
+                        (settings.pipelineStatistics ? PipelineStatistics : 0);
+        return {flags, static_cast<uint8_t>(settings.presentMode)};
+    }
+
+    SessionRecorder::EntityState SessionRecorder::captureEntity(const Graphics::Entity& entity) {
+        const auto& transform = entity.getTransform();
+        return {transform.getTranslation(), transform.getQuatRotation(), transform.getScale()};
+    }
+
+    void SessionRecorder::recordFrame(const Graphics::Camera& camera) {
+        if (!isRecording()) {
+            return;
+        }
+
+        uint8_t flags = 0;
+        auto cameraState = captureCamera(camera);
+        if (!m_HasPrevious || differs(cameraState, m_Camera)) {
+            m_Camera = cameraState;
+            flags |= CameraChanged;
+        }
+        auto settingsState = captureSettings(*GlobalSettings::instance());
+        if (!m_HasPrevious || differs(settingsState, m_Settings)) {
+            m_Settings = settingsState;
+            flags |= SettingsChanged;
+        }
+
+        m_EntityStates.resize(m_Entities.size());
+        m_ChangedEntities.clear();
+        for (uint32_t i = 0; i < m_Entities.size(); i++) {
+            auto entityState = captureEntity(*m_Entities[i]);
+            if (!m_HasPrevious || differs(entityState, m_EntityStates[i])) {
+                m_EntityStates[i] = entityState;
+                m_ChangedEntities.push_back(i);
+            }
+        }
+        if (!m_ChangedEntities.empty()) {
+            flags |= EntitiesChanged;
+        }
+        m_HasPrevious = true;
+
+        write(flags);
+        if (flags & CameraChanged) {
+            write(m_Camera);
+        }
+        if (flags & SettingsChanged) {
+            write(m_Settings);
+        }
+        if (flags & EntitiesChanged) {
+            write(static_cast<uint32_t>(m_ChangedEntities.size()));
+            for (auto index : m_ChangedEntities) {
+                write(index);
+                write(m_EntityStates[index]);
+            }
+        }
+        m_FrameCount++;
+    }
+
+    bool SessionRecorder::replayFrame(Graphics::Camera& camera) {
+        if (m_ReplayOffset >= m_Replay.size()) {
+            return false;
+        }
+
+        // The stream was validated when it was loaded
+        uint8_t flags = 0;
+        read(flags);
+        if (flags & CameraChanged) {
+            read(m_Camera);
+            camera.setFov(m_Camera.fov);
+            camera.setPosition(m_Camera.position);
+            // The rotation sets the up vector, the look at vector may have been set on its own
+            camera.setRotation(m_Camera.rotation);
+            camera.setLookAt(m_Camera.lookAt);
+        }
+        if (flags & SettingsChanged) {
+            read(m_Settings);
+            auto settings = GlobalSettings::instance();
+            settings->displayModels = m_Settings.flags & DisplayModels;
+            settings->displayBackground = m_Settings.flags & DisplayBackground;
+            settings->displayTerrain = m_Settings.flags & DisplayTerrain;
+            settings->logFps = m_Settings.flags & LogFps;
+            settings->pipelineStatistics = m_Settings.flags & PipelineStatistics;
+            settings->presentMode = static_cast<PresentMode>(m_Settings.presentMode);
+        }
+        if (flags & EntitiesChanged) {
+            uint32_t count = 0;
+            read(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t index = 0;
+                EntityState entityState = {};
+                read(index);
+                read(entityState);
+                if (index >= m_Entities.size()) {
+                    continue;
+                }
+                Transform transform;
+                transform.setTranslation(entityState.translation);
+                transform.setRotation(entityState.rotation);
+                transform.setScale(entityState.scale);
+                m_Entities[index]->setTransform(transform);
+            }
+        }
+        return true;
+    }
+}
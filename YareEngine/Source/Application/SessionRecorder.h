@@ -0,0 +1,106 @@
+#ifndef YARE_SESSION_RECORDER_H
+#define YARE_SESSION_RECORDER_H
+
+#include "Utilities/T_Singleton.h"
+#include "Application/GlobalSettings.h"
+#include "Graphics/Camera/Camera.h"
+#include "Graphics/Scene/Entity.h"
+#include "Graphics/Scene/StressScene.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Yare {
+
+    // What a session has to be replayed with to render the same scene
+    struct SessionInfo {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        Graphics::StressSceneInfo stressScene;
+    };
+
+    // Records the state every frame is rendered with, the camera, the global settings and the transforms of
+    // the tracked entities, and drives it back into a later run. Only what changed since the previous frame
+    // is written, a frame where nothing changed takes a single byte. State is captured after input handling
+    // and any scripted changes, so a replay renders the same frames without depending on how long they took.
+    // The stream is written in the byte order of the machine that records it.
+    class SessionRecorder : public Utilities::T_Singleton<SessionRecorder> {
+    public:
+        SessionRecorder() {}
+        ~SessionRecorder();
+
+        bool startRecording(const std::string& filePath, const SessionInfo& info);
+        // Reads the whole session up front, so replaying does not touch the disk
+        bool loadReplay(const std::string& filePath, SessionInfo& info);
+        // Flushes and closes the recording, or forgets the loaded replay
+        void stop();
+
+        // Entity i of the list is recorded as i, the list has to be created the same way for a replay to match.
+        // The caller clears the list before the entities are destroyed.
+        void setEntities(const std::vector<Graphics::Entity*>& entities) { m_Entities = entities; }
+
+        // Call once per frame right before it is rendered
+        void recordFrame(const Graphics::Camera& camera);
+        // Applies the state of the next recorded frame, false once every frame has been replayed
+        bool replayFrame(Graphics::Camera& camera);
+
+        bool     isRecording()      const { return m_Output.is_open(); }
+        bool     isReplaying()      const { return !m_Replay.empty(); }
+        uint32_t getFrameCount()    const { return m_FrameCount; }
+
+    private:
+        // Everything a frame is rendered with
+        struct CameraState {
+            glm::vec3 position;
+            glm::vec3 rotation;
+            glm::vec3 lookAt;
+            float fov;
+        };
+
+        struct SettingsState {
+            uint8_t flags;
+            uint8_t presentMode;
+        };
+
+        struct EntityState {
+            glm::vec3 translation;
+            glm::quat rotation;
+            glm::vec3 scale;
+        };
+
+        enum FrameFlags : uint8_t {
+            CameraChanged = 1 << 0,
+            SettingsChanged = 1 << 1,
+            EntitiesChanged = 1 << 2
+        };
+
+        static CameraState   captureCamera(const Graphics::Camera& camera);
+        static SettingsState captureSettings(const GlobalSettings& settings);
+        static EntityState   captureEntity(const Graphics::Entity& entity);
+
+        template <class T>
+        void write(const T& value) { m_Output.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+        template <class T>
+        bool read(T& value);
+
+    private:
+        std::vector<Graphics::Entity*> m_Entities;
+        uint32_t m_FrameCount = 0;
+
+        std::ofstream m_Output;
+        // The state last written, only changes to it are recorded
+        bool m_HasPrevious = false;
+        CameraState m_Camera = {};
+        SettingsState m_Settings = {};
+        std::vector<EntityState> m_EntityStates;
+
+        std::vector<uint8_t> m_Replay;
+        size_t m_ReplayOffset = 0;
+        // Reused to collect the entities that changed without allocating every frame
+        std::vector<uint32_t> m_ChangedEntities;
+    };
+}
+
+#endif // YARE_SESSION_RECORDER_H
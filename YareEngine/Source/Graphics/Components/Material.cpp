@@ -1,4 +1,5 @@
 #include "Material.h"
+#include "Graphics/Vulkan/Context.h"
 
 namespace Yare::Graphics {
 
@@ -16,6 +17,14 @@ namespace Yare::Graphics {
         }
     }
 
+    void Material::setTextureImage(Image* image) {
+        if (m_Texture != image) {
+            // The old texture may still be sampled by a frame in flight
+            VulkanContext::getContext()->getDeletionQueue()->destroy(m_Texture);
+            m_Texture = image;
+        }
+    }
+
     void Material::loadTextures() {
         switch (m_Type) {
         case MaterialTexType::TextureCube: {
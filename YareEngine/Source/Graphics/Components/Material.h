@@ -20,14 +20,22 @@ namespace Yare::Graphics {
 
         void loadTextures();
         void setImageIdx(int idx) { m_ImageIdx = idx; }
+        // Feature mask of the shader the material is drawn with, e.g. to enable alpha testing
+        void setShaderFeatures(uint32_t features) { m_ShaderFeatures = features; }
+        // Takes ownership of the image, the previous image is released
+        void setTextureImage(Image* image);
 
-        const Image* getTextureImage() const { return m_Texture; }
-        int          getImageIdx()     const { return m_ImageIdx; }
+        const Image*                    getTextureImage() const { return m_Texture; }
+        int                             getImageIdx()     const { return m_ImageIdx; }
+        uint32_t                        getShaderFeatures() const { return m_ShaderFeatures; }
+        MaterialTexType                 getType()         const { return m_Type; }
+        const std::vector<std::string>& getFilePaths()    const { return m_FilePaths; }
 
     private:
-        Image* m_Texture;
+        Image* m_Texture = nullptr;
         MaterialTexType m_Type;
         int m_ImageIdx = 0;
+        uint32_t m_ShaderFeatures = 0;
         std::vector<std::string> m_FilePaths;
     };
 
@@ -1,6 +1,8 @@
 #include "Mesh.h"
 #include "Utilities/IOHelper.h"
 
+#include <algorithm>
+
 namespace Yare::Graphics {
 
     Mesh::Mesh(const std::string& meshFilePath) {
@@ -33,6 +35,10 @@ namespace Yare::Graphics {
     }
 
     void Mesh::createBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        for (const auto& vertex : vertices) {
+            m_BoundingRadius = std::max(m_BoundingRadius, glm::length(vertex.pos));
+        }
+
         // Vertex Buffers
         VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
 
@@ -18,6 +18,8 @@ namespace Yare::Graphics {
 
         Buffer* getIndexBuffer() const { return m_IndexBuffer; }
         Buffer* getVertexBuffer() const { return m_VertexBuffer; }
+        // Radius of a sphere around the model space origin that contains every vertex
+        float   getBoundingRadius() const { return m_BoundingRadius; }
 
     protected:
         void createBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
@@ -25,6 +27,7 @@ namespace Yare::Graphics {
         Buffer* m_VertexBuffer = nullptr;
         Buffer* m_IndexBuffer = nullptr;
         std::string m_FilePath;
+        float m_BoundingRadius = 0.0f;
     };
 }
 
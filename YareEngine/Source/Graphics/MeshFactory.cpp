@@ -113,15 +113,20 @@ namespace Yare::Graphics {
     }
 
     Mesh* createQuadPlane(size_t width, size_t height) {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        generateQuadPlane(width, height, vertices, indices);
+        return new Mesh(vertices, indices);
+    }
+
+    void generateQuadPlane(size_t width, size_t height, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
         float positionX = 0;
         float positionZ = 0;
         int index = 0;
 
         size_t vertex_count = (width - 1) * (height - 1) * 6;
         size_t index_count = vertex_count; // duplicating
-        std::vector<Vertex> vertices;
         vertices.resize(vertex_count);
-        std::vector<uint32_t> indices;
         indices.resize(index_count);
 
         size_t vertex_height = 0; // Todo later with a heightmap
@@ -193,7 +198,6 @@ namespace Yare::Graphics {
 			index++;
             }
         }
-        return new Mesh(vertices, indices);
     }
 
     // Mesh* createSphere(float diameter) {
@@ -1,6 +1,11 @@
 #ifndef YARE_MESH_FACTORY_H
 #define YARE_MESH_FACTORY_H
 
+#include "Core/DataStructures.h"
+
+#include <cstdint>
+#include <vector>
+
 namespace Yare::Graphics {
     class Mesh;
 
@@ -19,6 +24,9 @@ namespace Yare::Graphics {
     Mesh* createCube(float size);
     Mesh* createQuad(float width, float height);
     Mesh* createQuadPlane(size_t width, size_t height);
+
+    // The vertices and indices createQuadPlane uploads, without touching the GPU
+    void generateQuadPlane(size_t width, size_t height, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
     // Mesh* createSphere(float diameter);
     // Mesh* createTorus();
     // Mesh* createRect(float width, float height, float depth);
@@ -1,33 +1,68 @@
 #include "Graphics/RenderManager.h"
 
 #include "Graphics/Vulkan/Utilities.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Graphics/Renderers/ForwardRenderer.h"
 #include "Graphics/Renderers/ImGuiRenderer.h"
 #include "Graphics/Renderers/SkyboxRenderer.h"
+#include "Graphics/Renderers/TerrainRenderer.h"
 
 #include "Graphics/Window/GlfwWindow.h"
+#include "Utilities/Logger.h"
+#include "Utilities/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace Yare::Graphics {
 
-    RenderManager::RenderManager(const std::shared_ptr<Window> window):
+    namespace {
+        // Readback buffers are only allocated once a capture needs them, so the ring may be as deep as an
+        // eighth of the host visible memory allows. Batches then keep rendering while the writers catch up.
+        uint32_t chooseReadbackSlotCount(uint32_t width, uint32_t height, uint32_t minimum) {
+            VkPhysicalDeviceMemoryProperties memProperties;
+            vkGetPhysicalDeviceMemoryProperties(Devices::instance()->getGPU(), &memProperties);
+
+            VkDeviceSize hostVisible = 0;
+            for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+                if (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+                    auto heap = memProperties.memoryTypes[i].heapIndex;
+                    hostVisible = std::max(hostVisible, memProperties.memoryHeaps[heap].size);
+                }
+            }
+
+            VkDeviceSize frameSize = std::max<VkDeviceSize>(static_cast<VkDeviceSize>(width) * height * 4, 1);
+            auto slots = static_cast<uint32_t>(std::min<VkDeviceSize>(hostVisible / 8 / frameSize, 16));
+            return std::max(slots, minimum);
+        }
+    }
+
+    RenderManager::RenderManager(const std::shared_ptr<Window> window, PresentMode presentMode, uint32_t imageCount,
+                                 const StressSceneInfo& stressScene):
         m_WindowRef(window) {
-        init();
+        init(presentMode, imageCount, stressScene);
     }
 
     RenderManager::~RenderManager() {
         Devices::instance()->waitIdle();
 
+        // Writes out the captures that are still queued
+        m_FrameReadback->flush();
+        auto captureStatistics = m_FrameReadback->getStatistics();
+        if (captureStatistics.captured > 0) {
+            YZ_INFO("Captured " + STR(captureStatistics.captured) + " frames at " + STR(m_WindowWidth) + "x" +
+                    STR(m_WindowHeight) + ", " + STR(m_FrameReadback->getCaptureRate()) + " frames per second, " +
+                    STR(captureStatistics.stalls) + " stalls");
+        }
+        delete m_FrameReadback;
+
         for (auto renderer : m_Renderers){
             delete renderer;
         }
 
         delete m_DepthBuffer;
 
-        for (auto commandBuffer : m_CommandBuffers) {
-            delete commandBuffer;
-        }
-        m_CommandBuffers.clear();
-
         for (auto frameBuffer : m_FrameBuffers) {
             delete frameBuffer;
         }
@@ -40,14 +75,26 @@ namespace Yare::Graphics {
 
     void RenderManager::renderScene() {
         begin();
+        auto& profiler = *m_VulkanContext->getGpuProfiler();
         for (const auto renderer : m_Renderers) {
-            renderer->prepareScene();
-            renderer->present(m_CommandBuffers[m_CurrentBufferID]);
+            YZ_PROFILE_SCOPE(renderer->getName());
+            {
+                YZ_PROFILE_SCOPE("prepareScene");
+                renderer->prepareScene();
+            }
+            YZ_PROFILE_SCOPE("present");
+            GpuProfiler::Scope scope(profiler, *m_CommandBuffer, renderer->getName());
+            renderer->present(m_CommandBuffer);
         }
         end();
     }
 
     void RenderManager::begin() {
+        YZ_PROFILE_SCOPE("RenderManager::begin");
+        // The present mode or image count was changed at runtime
+        if (m_VulkanContext->getRenderTarget()->isOutdated()) {
+            onResize();
+        }
 
         // Renderer will ask the swapchain to get the next image (frame)
         // for us to work with, if the result is OUT_OF_DATA_KHR or SUBOPTIMAL_KHR
@@ -56,40 +103,111 @@ namespace Yare::Graphics {
             onResize();
         }
 
-        m_CurrentBufferID = m_VulkanContext->getSwapchain()->getCurrentImage();
+        m_CurrentBufferID = m_VulkanContext->getRenderTarget()->getCurrentImage();
+
+        // Whatever is counted from here on is recorded for this frame
+        RenderStatistics::instance()->beginFrame();
 
-        m_CommandBuffers[m_CurrentBufferID]->beginRecording();
+        m_CommandBuffer = m_VulkanContext->getFrameCommandPools()->getCommandBuffer();
+        m_CommandBuffer->beginRecording();
+        // Resets the frame's queries, which can't be done inside the render pass
+        m_VulkanContext->getGpuProfiler()->beginFrame(*m_CommandBuffer, m_VulkanContext->getCurrentFrame(),
+                                                      m_PipelineStatistics);
 
-        m_RenderPass->beginRenderPass(m_CommandBuffers[m_CurrentBufferID], m_FrameBuffers[m_CurrentBufferID]);
+        m_RenderPass->beginRenderPass(m_CommandBuffer, m_FrameBuffers[m_CurrentBufferID]);
+        m_VulkanContext->getGpuProfiler()->beginPipelineStatistics(*m_CommandBuffer);
     }
 
     void RenderManager::end() {
-        m_RenderPass->endRenderPass(m_CommandBuffers[m_CurrentBufferID]);
+        YZ_PROFILE_SCOPE("RenderManager::end");
+        m_VulkanContext->getGpuProfiler()->endPipelineStatistics(*m_CommandBuffer);
+        m_RenderPass->endRenderPass(m_CommandBuffer);
+        for (const auto renderer : m_Renderers) {
+            renderer->endFrame(m_CommandBuffer);
+        }
 
-        m_CommandBuffers[m_CurrentBufferID]->endRecording();
+        if (!m_CapturePath.empty()) {
+            GpuProfiler::Scope scope(*m_VulkanContext->getGpuProfiler(), *m_CommandBuffer, "Capture");
+            if (!m_FrameReadback->record(*m_CommandBuffer, *m_VulkanContext->getRenderTarget(), m_CurrentBufferID,
+                                         m_CapturePath)) {
+                YZ_WARN("The rendered images can't be read back, not capturing " + m_CapturePath);
+            }
+            m_CapturePath.clear();
+        }
+
+        m_VulkanContext->getGpuProfiler()->endFrame(*m_CommandBuffer);
+        m_CommandBuffer->endRecording();
+
+        // Submits even if the swapchain has to be recreated
+        bool presented = m_VulkanContext->present(m_CommandBuffer);
+        m_FrameReadback->submitted(m_VulkanContext->getFrameTimeline()->getPendingValue());
+        m_FrameReadback->update();
 
-        if (!m_VulkanContext->present(m_CommandBuffers[m_CurrentBufferID])) {
+        if (!presented) {
             onResize();
         }
     }
 
-    void RenderManager::init() {
+    void RenderManager::setPresentMode(PresentMode presentMode, uint32_t imageCount) {
+        m_VulkanContext->getRenderTarget()->setPresentMode(presentMode, imageCount);
+    }
+
+    std::vector<Entity*> RenderManager::getEntities() const {
+        std::vector<Entity*> entities;
+        for (auto renderer : m_Renderers) {
+            renderer->getEntities(entities);
+        }
+        return entities;
+    }
+
+    void RenderManager::requestCapture(const std::string& filePath) {
+        m_CapturePath = filePath;
+    }
+
+    FrameReadback::Statistics RenderManager::flushCaptures() {
+        m_FrameReadback->flush();
+        return m_FrameReadback->getStatistics();
+    }
+
+    void RenderManager::init(PresentMode presentMode, uint32_t imageCount, const StressSceneInfo& stressScene) {
         auto props = m_WindowRef->getWindowProperties();
         m_WindowWidth =  props.width;
         m_WindowHeight = props.height;
-        m_VulkanContext = new VulkanContext(m_WindowWidth, m_WindowHeight);
+        m_VulkanContext = new VulkanContext(m_WindowWidth, m_WindowHeight, m_WindowRef->isHeadless(),
+                                            presentMode, imageCount);
+        // The copies of every frame in flight are pending on the GPU at once, the slots beyond those
+        // keep the render loop going while the workers encode
+        auto slotCount = chooseReadbackSlotCount(m_WindowWidth, m_WindowHeight,
+                                                 m_VulkanContext->getMaxFramesInFlight() + 2);
+        m_FrameReadback = new FrameReadback(m_VulkanContext->getFrameTimeline(), slotCount,
+                                            std::max(2u, std::thread::hardware_concurrency() / 2));
         createRenderPass();
         createFrameBuffers();
-        createCommandBuffers();
+
+        auto startTime = std::chrono::high_resolution_clock::now();
         m_Renderers.emplace_back(new SkyboxRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight));
-        m_Renderers.emplace_back(new ForwardRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight));
-        m_Renderers.emplace_back(new ImGuiRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight));
+        if (TerrainRenderer::isSupported()) {
+            m_Renderers.emplace_back(new TerrainRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight,
+                                                         stressScene.terrainSize));
+        } else {
+            YZ_WARN("Terrain shaders or fragment stores unavailable, terrain will not be rendered");
+        }
+        m_Renderers.emplace_back(new ForwardRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight, stressScene));
+        // Nobody can interact with the settings overlay of a headless run, keep it out of the frames
+        if (!m_WindowRef->isHeadless()) {
+            m_Renderers.emplace_back(new ImGuiRenderer(m_RenderPass, m_WindowWidth, m_WindowHeight));
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime);
+
+        YZ_INFO("Renderers created in " + STR(elapsed.count()) + "ms (" +
+                (m_VulkanContext->getPipelineCache()->isWarm() ? "warm" : "cold") + " pipeline cache)");
     }
 
     void RenderManager::createRenderPass() {
         RenderPassInfo renderPassInfo{};
-        renderPassInfo.imageFormat = m_VulkanContext->getSwapchain()->getImageFormat();
+        renderPassInfo.imageFormat = m_VulkanContext->getRenderTarget()->getImageFormat();
         renderPassInfo.extent = VkExtent2D{m_WindowWidth, m_WindowHeight};
+        renderPassInfo.finalLayout = m_VulkanContext->getRenderTarget()->getFinalLayout();
         m_RenderPass = new RenderPass(renderPassInfo);
     }
 
@@ -104,48 +222,38 @@ namespace Yare::Graphics {
         framebufferInfo.height = m_WindowHeight;
         framebufferInfo.layers = 1;
 
-        for (uint32_t i = 0; i < m_VulkanContext->getSwapchain()->getImageViewSize(); i++) {
-            framebufferInfo.attachments = { m_VulkanContext->getSwapchain()->getImageView(i),
+        for (uint32_t i = 0; i < m_VulkanContext->getRenderTarget()->getImageViewSize(); i++) {
+            framebufferInfo.attachments = { m_VulkanContext->getRenderTarget()->getImageView(i),
                                             m_DepthBuffer->getImageView() };
             m_FrameBuffers.push_back(new Framebuffer(framebufferInfo));
         }
     }
 
-    void RenderManager::createCommandBuffers() {
-        m_CommandBuffers.resize(m_FrameBuffers.size());
-
-        for (unsigned int i = 0; i < m_CommandBuffers.size(); i++) {
-            m_CurrentBufferID = i;
-
-            m_CommandBuffers[i] = new CommandBuffer();
-        }
-    }
-
     void RenderManager::onResize() {
-        // CleanUp
-        {
-            for (auto commandBuffer : m_CommandBuffers) {
-                delete commandBuffer;
-            }
-            m_CommandBuffers.clear();
+        auto startTime = std::chrono::high_resolution_clock::now();
 
+        // Only the attachments follow the size of the swapchain, the render pass,
+        // pipelines and descriptors are all independent of it. The old ones may
+        // still be in use by the last frame, so they are retired rather than deleted.
+        {
+            auto& deletionQueue = m_VulkanContext->getDeletionQueue();
             for (auto frameBuffer : m_FrameBuffers) {
-                delete frameBuffer;
+                deletionQueue->destroy(frameBuffer);
             }
             m_FrameBuffers.clear();
 
-            delete m_DepthBuffer;
-            delete m_RenderPass;
+            deletionQueue->destroy(m_DepthBuffer);
         }
         m_WindowWidth =  m_WindowRef->getWindowProperties().width;
         m_WindowHeight = m_WindowRef->getWindowProperties().height;
         m_VulkanContext->onResize(m_WindowWidth, m_WindowHeight);
-        createRenderPass();
+        m_RenderPass->setExtent(VkExtent2D{m_WindowWidth, m_WindowHeight});
         createFrameBuffers();
-        createCommandBuffers();
 
         for (auto renderer : m_Renderers) {
-            renderer->onResize(m_RenderPass, m_WindowWidth, m_WindowHeight);
+            renderer->onResize(m_WindowWidth, m_WindowHeight);
         }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime);
+        YZ_INFO("Resized to " + STR(m_WindowWidth) + "x" + STR(m_WindowHeight) + " in " + STR(elapsed.count()) + "ms");
     }
 }
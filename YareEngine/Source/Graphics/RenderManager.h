@@ -6,40 +6,61 @@
 #include "Graphics/Vulkan/CommandBuffer.h"
 #include "Graphics/Vulkan/RenderPass.h"
 #include "Graphics/Vulkan/Image.h"
+#include "Graphics/Vulkan/FrameReadback.h"
 
 #include "Graphics/Window/Window.h"
 
 #include "Graphics/Renderers/Renderer.h"
+#include "Graphics/Scene/StressScene.h"
 
 namespace Yare::Graphics {
 
     class RenderManager {
     public:
-        RenderManager(const std::shared_ptr<Window> window);
+        // A stress scene with entities replaces the regular scene, its terrain size applies either way
+        RenderManager(const std::shared_ptr<Window> window, PresentMode presentMode, uint32_t imageCount,
+                      const StressSceneInfo& stressScene = {});
         ~RenderManager();
 
         void renderScene();
+        // A change recreates the swapchain before the next frame, headless rendering ignores it
+        void setPresentMode(PresentMode presentMode, uint32_t imageCount);
+        // Queries pipeline statistics from the next frame on, where the device supports them
+        void setPipelineStatistics(bool enabled) { m_PipelineStatistics = enabled; }
+        // Every entity that is drawn, they live as long as the render manager
+        std::vector<Entity*> getEntities() const;
         void begin();
         void end();
 
+        // Writes the next rendered frame to filePath a few frames after it has completed,
+        // see Utilities::writeImage for the formats
+        void requestCapture(const std::string& filePath);
+        // Blocks until every requested capture has been written
+        FrameReadback::Statistics flushCaptures();
+
     protected:
-        void init();
+        void init(PresentMode presentMode, uint32_t imageCount, const StressSceneInfo& stressScene);
         void createRenderPass();
         void createFrameBuffers();
-        void createCommandBuffers();
         void onResize();
 
     private:
         // Constructs the instance, devices and swapchain required for rendering
         VulkanContext*                       m_VulkanContext;
         std::vector<Framebuffer*>            m_FrameBuffers;
-        std::vector<CommandBuffer*>          m_CommandBuffers;
+        // Recorded this frame, owned by the context's frame command pools
+        CommandBuffer*                       m_CommandBuffer = nullptr;
         RenderPass*                          m_RenderPass;
         Image*                               m_DepthBuffer;
         const std::shared_ptr<Window>        m_WindowRef;
         // TODO: Find a better naming scheme
         std::vector<Renderer*>               m_Renderers;
 
+        // Requested for the frame being rendered
+        std::string                          m_CapturePath;
+        FrameReadback*                       m_FrameReadback = nullptr;
+        bool                                 m_PipelineStatistics = false;
+
         uint32_t m_CurrentBufferID = 0;
         uint32_t m_WindowWidth = 0;
         uint32_t m_WindowHeight = 0;
@@ -6,13 +6,32 @@
 
 #include "Graphics/Vulkan/Utilities.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Graphics/MeshFactory.h"
+#include "Graphics/Scene/StressScene.h"
 
 #include "Core/Memory.h"
 
+#include <algorithm>
+
 namespace Yare::Graphics {
 
-    ForwardRenderer::ForwardRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
+    ForwardRenderer::ForwardRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight,
+                                     StressSceneInfo stressScene) {
+        if (stressScene.entityCount > 0) {
+            // Every entity has a slot in the dynamic uniform buffer, every texture one in the descriptor array
+            if (stressScene.entityCount > MAX_OBJECTS || stressScene.textureCount > MAX_NUM_TEXTURES) {
+                YZ_WARN("The stress scene is limited to " + STR(MAX_OBJECTS) + " entities and " +
+                        STR(MAX_NUM_TEXTURES) + " textures");
+                stressScene.entityCount = std::min<uint32_t>(stressScene.entityCount, MAX_OBJECTS);
+                stressScene.textureCount = std::min<uint32_t>(stressScene.textureCount, MAX_NUM_TEXTURES);
+            }
+            createStressScene(stressScene, m_Meshes, m_Materials, m_Entities);
+            init(renderPass, windowWidth, windowHeight);
+            return;
+        }
+
         m_Meshes.push_back(std::make_shared<Mesh>("../Res/Models/viking_room.obj"));
         m_Meshes.emplace_back(createMesh(PrimativeShape::CUBE));
         m_Meshes.emplace_back(createQuadPlane(100, 100));
@@ -24,6 +43,9 @@ namespace Yare::Graphics {
         m_Materials.push_back(std::make_shared<Material>("../Res/Textures/skysphere.png"));
         m_Materials.push_back(std::make_shared<Material>("../Res/Textures/sprite.jpg"));
         m_Materials.push_back(std::make_shared<Material>("../Res/Textures/tile.png"));
+        // Its transparent texels are cut out, see createGraphicsPipeline
+        m_Materials.push_back(std::make_shared<Material>("../Res/Textures/engineLogo.png"));
+        m_AlphaTestedMaterials.push_back(m_Materials.back());
 
         Transform transform{glm::vec3(3.0f, -0.15f, 0.0f),
                             glm::radians(glm::vec3(90.0f, 90.0f, -180.0f)),
@@ -38,6 +60,9 @@ namespace Yare::Graphics {
         m_Entities.push_back(std::make_shared<Entity>(m_Meshes[1], m_Materials[3], transform2));
         transform2.setTranslation(0.0f, 0.0f, 1.0f);
         m_Entities.push_back(std::make_shared<Entity>(m_Meshes[1], m_Materials[4], transform2));
+        // Added last so the entities of recorded sessions keep their index
+        transform2.setTranslation(0.0f, 0.0f, -1.0f);
+        m_Entities.push_back(std::make_shared<Entity>(m_Meshes[1], m_Materials[6], transform2));
 
         init(renderPass, windowWidth, windowHeight);
     }
@@ -47,23 +72,38 @@ namespace Yare::Graphics {
             alignedFree(m_UboDynamicData.model);
         }
 
-        delete m_Pipeline;
 
-        delete m_UniformBuffers.view;
-        delete m_UniformBuffers.dynamic;
+        for (auto& uniformBuffers : m_UniformBuffers) {
+            delete uniformBuffers.view;
+            delete uniformBuffers.dynamic;
+        }
+        delete m_DescriptorSet;
+
+        delete m_TextureStreamer;
+    }
 
+    void ForwardRenderer::getEntities(std::vector<Entity*>& entities) const {
+        for (const auto& entity : m_Entities) {
+            entities.push_back(entity.get());
+        }
     }
 
     void ForwardRenderer::init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
+        m_ViewportHeight = windowHeight;
+
+        // Only the low mips are loaded here, the rest are streamed in as entities come into view
+        TextureStreamerInfo streamerInfo = {};
+        streamerInfo.budgetBytes = static_cast<size_t>(GlobalSettings::instance()->textureBudgetMiB) * 1024 * 1024;
+        m_TextureStreamer = new TextureStreamer(streamerInfo);
         for (auto material : m_Materials) {
-            material->loadTextures();
+            m_TextureStreamer->registerMaterial(material);
         }
 
-        createGraphicsPipeline(renderPass, windowWidth, windowHeight);
+        createGraphicsPipeline(renderPass);
 
         prepareUniformBuffers();
 
-        createDescriptorSets();
+        createDescriptorSet();
     }
 
 
@@ -73,66 +113,56 @@ namespace Yare::Graphics {
         for (const auto entity : m_Entities){
             submit(entity.get());
         }
+
+        m_TextureStreamer->setBudgetBytes(static_cast<size_t>(GlobalSettings::instance()->textureBudgetMiB) * 1024 * 1024);
+        m_TextureStreamer->updateResidency(m_CommandQueue, *Application::getAppInstance()->getWindow()->getCamera(),
+                                           m_ViewportHeight);
+        // Replaced images are retired through the deletion queue, the set written below picks up the new ones
+        // while the frame in flight keeps the set it was recorded with
+        m_TextureStreamer->processUploads();
+        updateDescriptorSet(VulkanContext::getContext()->getCurrentFrame());
     }
 
     void ForwardRenderer::present(CommandBuffer* commandBuffer) {
-        if (GlobalSettings::instance()->displayModels) {
+        if (GlobalSettings::instance()->displayModels && m_Pipeline->isReady()) {
+            auto frame = VulkanContext::getContext()->getCurrentFrame();
             int index = 0;
             for (auto& command : m_CommandQueue) {
 
                 uint32_t dynamicOffset = index * static_cast<uint32_t>(m_DynamicAlignment);
-                updateUniformBuffers(index, command.entity->getTransform());
-                m_Pipeline->setActive(*commandBuffer);
+                updateUniformBuffers(frame, index, command.entity->getTransform());
+                m_Pipeline->setActive(*commandBuffer, command.entity->getMaterial()->getShaderFeatures());
 
                 int imageIdx = command.entity->getMaterial()->getImageIdx();
                 vkCmdPushConstants(commandBuffer->getCommandBuffer(), m_Pipeline->getPipelineLayout(),
-                                   VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(int), (void *)&imageIdx);
+                                   m_Pipeline->getPushConstantRange().stageFlags, 0, sizeof(int), (void *)&imageIdx);
 
-                vkCmdBindDescriptorSets(commandBuffer->getCommandBuffer(),
-                                        VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline->getPipelineLayout(), 0u,
-                                        1u, &m_DescriptorSet->getDescriptorSet(0), 1, &dynamicOffset);
+                m_DescriptorSet->bind(*commandBuffer, 1, &dynamicOffset);
 
                 command.entity->getMesh()->getVertexBuffer()->bindVertex(commandBuffer, 0);
                 command.entity->getMesh()->getIndexBuffer()->bindIndex(commandBuffer, VK_INDEX_TYPE_UINT32);
 
                 auto indicesCount = command.entity->getMesh()->getIndexBuffer()->getSize() / sizeof(uint32_t);
                 vkCmdDrawIndexed(commandBuffer->getCommandBuffer(), static_cast<uint32_t>(indicesCount), 1, 0, 0, 0);
+                RenderStatistics::instance()->addDraw(static_cast<uint32_t>(indicesCount), 1);
                 index++;
             }
         }
     }
 
-    void ForwardRenderer::onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) {
-        // Cleanup
-        {
-            if (m_UboDynamicData.model) {
-                alignedFree(m_UboDynamicData.model);
-            }
-
-            delete m_Pipeline;
-
-            delete m_UniformBuffers.view;
-            delete m_UniformBuffers.dynamic;
-
-        }
-        createGraphicsPipeline(renderPass, newWidth, newHeight);
-        prepareUniformBuffers();
-        createDescriptorSets();
+    void ForwardRenderer::onResize(uint32_t newWidth, uint32_t newHeight) {
+        // Only used to estimate texture coverage, the pipeline and buffers are size independent
+        m_ViewportHeight = newHeight;
     }
 
-    void ForwardRenderer::createGraphicsPipeline(RenderPass* renderPass, uint32_t width, uint32_t height) {
-        Shader shader("../Res/Shaders", "texture_array.shader");
-
+    void ForwardRenderer::createGraphicsPipeline(RenderPass* renderPass) {
         PipelineInfo pInfo = {};
-        pInfo.shader = &shader;
+        pInfo.shaderPath = "../Res/Shaders";
+        pInfo.shaderName = "texture_array.shader";
         pInfo.renderpass = renderPass;
         pInfo.cullMode = VK_CULL_MODE_BACK_BIT;
         pInfo.depthTestEnable = VK_TRUE;
         pInfo.depthWriteEnable = VK_TRUE;
-        pInfo.maxObjects = 2;
-        pInfo.width = width;
-        pInfo.height = height;
-        pInfo.pushConstants = {VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(int)};
         pInfo.bindingDescription =  VkVertexInputBindingDescription{0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX};
 
         // location, binding, format, offset
@@ -142,49 +172,54 @@ namespace Yare::Graphics {
         pInfo.vertexInputAttributes = { pos, uv, normal };
 
 
+        // The rest of the layout is reflected from the shader
         // binding, descriptorType, descriptorCount, stageFlags, pImmuatbleSamplers
-        VkDescriptorSetLayoutBinding projView = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                                 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
         VkDescriptorSetLayoutBinding model =    {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                  1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
+        // Every material texture is sampled the same way, so the sampler is baked into the layout
+        std::vector<VkSampler> immutableSamplers(MAX_NUM_TEXTURES,
+                                                 VulkanContext::getContext()->getSamplerCache()->getSampler(SamplerInfo{}));
         VkDescriptorSetLayoutBinding sampler =  {2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                                 MAX_NUM_TEXTURES, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr};
-        pInfo.layoutBindings = { projView, model, sampler };
+                                                 MAX_NUM_TEXTURES, VK_SHADER_STAGE_FRAGMENT_BIT, immutableSamplers.data()};
+        pInfo.layoutBindings = { model, sampler };
 
-        m_Pipeline = new Pipeline();
-        m_Pipeline->init(pInfo);
+        m_Pipeline = VulkanContext::getContext()->getPipelineRegistry()->getPipeline(pInfo);
+
+        auto alphaTest = m_Pipeline->getFeatureMask({"ALPHA_TEST"});
+        for (const auto& material : m_AlphaTestedMaterials) {
+            material->setShaderFeatures(alphaTest);
+        }
     }
 
-    void ForwardRenderer::createDescriptorSets() {
+    void ForwardRenderer::createDescriptorSet() {
         DescriptorSetInfo descriptorSetInfo;
-        descriptorSetInfo.descriptorSetCount = 1;
-        descriptorSetInfo.pipeline = m_Pipeline;
+        descriptorSetInfo.pipeline = m_Pipeline.get();
+        descriptorSetInfo.transient = true;
 
-        // First create the descriptor set, but the buffers are empty
+        // Nothing is allocated until the first frame writes the set
         m_DescriptorSet = new DescriptorSet();
         m_DescriptorSet->init(descriptorSetInfo);
+    }
 
-
+    void ForwardRenderer::updateDescriptorSet(uint32_t frame) {
         std::vector<BufferInfo> bufferInfos = {};
         BufferInfo viewBufferInfo = {};
-        viewBufferInfo.buffer = m_UniformBuffers.view->getBuffer();
+        viewBufferInfo.buffer = m_UniformBuffers[frame].view->getBuffer();
         viewBufferInfo.offset = 0;
         viewBufferInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         viewBufferInfo.size = sizeof(UniformVS);
         viewBufferInfo.binding = 0;
         viewBufferInfo.imageSampler = nullptr;
         viewBufferInfo.imageView = nullptr;
-        viewBufferInfo.descriptorCount = 1;
 
         BufferInfo dynamicBufferInfo = {};
-        dynamicBufferInfo.buffer = m_UniformBuffers.dynamic->getBuffer();
+        dynamicBufferInfo.buffer = m_UniformBuffers[frame].dynamic->getBuffer();
         dynamicBufferInfo.offset = 0;
         dynamicBufferInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         dynamicBufferInfo.size = sizeof(glm::mat4);
         dynamicBufferInfo.binding = 1;
         dynamicBufferInfo.imageSampler = nullptr;
         dynamicBufferInfo.imageView = nullptr;
-        dynamicBufferInfo.descriptorCount = 1;
 
         bufferInfos.push_back(viewBufferInfo);
         bufferInfos.push_back(dynamicBufferInfo);
@@ -192,7 +227,6 @@ namespace Yare::Graphics {
         BufferInfo imageBufferInfo = {};
         imageBufferInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         imageBufferInfo.binding = 2;
-        imageBufferInfo.descriptorCount = MAX_NUM_TEXTURES;
 
         int imageIdx = 0;
         for (auto material : m_Materials) {
@@ -223,23 +257,26 @@ namespace Yare::Graphics {
         VkDeviceSize dynamicBufferSize = MAX_OBJECTS * m_DynamicAlignment;
         m_UboDynamicData.model = (glm::mat4*)alignedAlloc(dynamicBufferSize, m_DynamicAlignment);
 
-        m_UniformBuffers.view = new Buffer(BufferUsage::UNIFORM, viewBufferSize, nullptr);
-        m_UniformBuffers.dynamic = new Buffer(BufferUsage::DYNAMIC, dynamicBufferSize, nullptr);
+        m_UniformBuffers.resize(VulkanContext::getContext()->getMaxFramesInFlight());
+        for (auto& uniformBuffers : m_UniformBuffers) {
+            uniformBuffers.view = new Buffer(BufferUsage::UNIFORM, viewBufferSize, nullptr);
+            uniformBuffers.dynamic = new Buffer(BufferUsage::DYNAMIC, dynamicBufferSize, nullptr);
+        }
     }
 
-    void ForwardRenderer::updateUniformBuffers(uint32_t index, const Transform& transform) {
+    void ForwardRenderer::updateUniformBuffers(uint32_t frame, uint32_t index, const Transform& transform) {
         // TODO, store UBOs for each model we want to display in one UBO, separated by an offset
         // then bind based on that offset in the present call
         glm::mat4* uboDynamicModelPtr = (glm::mat4*)((uint64_t)m_UboDynamicData.model + (index * m_DynamicAlignment));
         *uboDynamicModelPtr = transform.getMatrix();
 
-        m_UniformBuffers.dynamic->setDynamicData(sizeof(glm::mat4), uboDynamicModelPtr, index * m_DynamicAlignment);
+        m_UniformBuffers[frame].dynamic->setDynamicData(sizeof(glm::mat4), uboDynamicModelPtr, index * m_DynamicAlignment);
 
         UniformVS uboVS = {};
         uboVS.view = Application::getAppInstance()->getWindow()->getCamera()->getViewMatrix();
         uboVS.projection = Application::getAppInstance()->getWindow()->getCamera()->getProjectionMatrix();
         uboVS.projection[1][1] *= -1;
 
-        m_UniformBuffers.view->setData(sizeof(uboVS), &uboVS);
+        m_UniformBuffers[frame].view->setData(sizeof(uboVS), &uboVS);
     }
 }
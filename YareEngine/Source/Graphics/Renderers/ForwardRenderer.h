@@ -5,6 +5,8 @@
 #include "Graphics/Vulkan/Pipeline.h"
 #include "Graphics/Vulkan/Buffer.h"
 #include "Graphics/Vulkan/DescriptorSet.h"
+#include "Graphics/Streaming/TextureStreamer.h"
+#include "Graphics/Scene/StressScene.h"
 
 #include <memory>
 
@@ -14,34 +16,46 @@ namespace Yare::Graphics {
 
     class ForwardRenderer  : public Renderer {
     public:
-        ForwardRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight);
+        // Renders the stress scene instead of the regular one when it has entities
+        ForwardRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight,
+                        StressSceneInfo stressScene);
         ~ForwardRenderer() override;
 
         void prepareScene() override;
         void present(CommandBuffer* commandBuffer) override;
-        void onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) override;
+        const char* getName() const override { return "Forward"; }
+        void getEntities(std::vector<Entity*>& entities) const override;
+        void onResize(uint32_t newWidth, uint32_t newHeight) override;
 
     private:
         void init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) override;
-        void createGraphicsPipeline(RenderPass* renderPass, uint32_t width, uint32_t height);
-        void createDescriptorSets();
+        void createGraphicsPipeline(RenderPass* renderPass);
+        void createDescriptorSet();
+        void updateDescriptorSet(uint32_t frame);
         void prepareUniformBuffers();
-        void updateUniformBuffers(uint32_t index, const Transform& transform);
+        void updateUniformBuffers(uint32_t frame, uint32_t index, const Transform& transform);
 
         // TODO Move this into some content management class
         std::vector<std::shared_ptr<Mesh>> m_Meshes;
         std::vector<std::shared_ptr<Material>> m_Materials;
         std::vector<std::shared_ptr<Entity>> m_Entities;
+        // Drawn with the ALPHA_TEST variant of the pipeline
+        std::vector<std::shared_ptr<Material>> m_AlphaTestedMaterials;
 
         uint64_t m_DynamicAlignment = 0;
 
-        Pipeline*  m_Pipeline;
+        std::shared_ptr<Pipeline> m_Pipeline;
+        // Written for every frame from that frame's descriptor allocator
         DescriptorSet* m_DescriptorSet;
+        TextureStreamer* m_TextureStreamer;
+        uint32_t m_ViewportHeight = 0;
 
         struct UniformBuffers {
             Buffer* view;
             Buffer* dynamic;
-        } m_UniformBuffers;
+        };
+        // Indexed by the frame in flight, a frame never writes what the previous one may still be reading
+        std::vector<UniformBuffers> m_UniformBuffers;
 
         UboDataDynamic m_UboDynamicData;
     };
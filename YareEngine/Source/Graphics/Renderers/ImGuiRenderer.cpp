@@ -9,6 +9,8 @@
 #include "imgui/imgui_impl_vulkan.h"
 
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 
 namespace Yare::Graphics {
     ImGuiRenderer::ImGuiRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
@@ -17,9 +19,12 @@ namespace Yare::Graphics {
 
     ImGuiRenderer::~ImGuiRenderer() {
         delete m_Font;
-        delete m_Pipeline;
-        delete m_IndexBuffer;
-        delete m_VertexBuffer;
+        for (auto indexBuffer : m_IndexBuffers) {
+            delete indexBuffer;
+        }
+        for (auto vertexBuffer : m_VertexBuffers) {
+            delete vertexBuffer;
+        }
     }
 
     void ImGuiRenderer::init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
@@ -40,24 +45,21 @@ namespace Yare::Graphics {
 
         createGraphicsPipeline(renderPass);
         createDescriptorSet();
+
+        m_IndexBuffers.resize(VulkanContext::getContext()->getMaxFramesInFlight(), nullptr);
+        m_VertexBuffers.resize(VulkanContext::getContext()->getMaxFramesInFlight(), nullptr);
     }
 
     void ImGuiRenderer::createGraphicsPipeline(RenderPass* renderPass) {
-        Shader shader("../Res/Shaders", "gui.shader");
-
         PipelineInfo pInfo = {};
-        pInfo.shader = &shader;
+        pInfo.shaderPath = "../Res/Shaders";
+        pInfo.shaderName = "gui.shader";
         pInfo.renderpass = renderPass;
         pInfo.cullMode = VK_CULL_MODE_NONE;
         pInfo.depthTestEnable = VK_FALSE;
         pInfo.depthWriteEnable = VK_FALSE;
-        pInfo.maxObjects = 2;
-        pInfo.width = (size_t)ImGui::GetIO().DisplaySize.x;
-        pInfo.height = (size_t)ImGui::GetIO().DisplaySize.y;
         pInfo.colorBlendingEnabled = true;
-        pInfo.dynamicStates.emplace_back(VK_DYNAMIC_STATE_VIEWPORT);
-        pInfo.dynamicStates.emplace_back(VK_DYNAMIC_STATE_SCISSOR);
-        pInfo.pushConstants = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstBlock)};
+        pInfo.pushDescriptors = true;
         pInfo.bindingDescription = VkVertexInputBindingDescription{0, sizeof(ImDrawVert),
                                                                    VK_VERTEX_INPUT_RATE_VERTEX};
 
@@ -66,12 +68,7 @@ namespace Yare::Graphics {
         VkVertexInputAttributeDescription col = {2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(ImDrawVert, col)};
         pInfo.vertexInputAttributes = {pos, uv, col};
 
-        VkDescriptorSetLayoutBinding sampler = {2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                                1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr};
-        pInfo.layoutBindings = { sampler };
-
-        m_Pipeline = new Pipeline();
-        m_Pipeline->init(pInfo);
+        m_Pipeline = VulkanContext::getContext()->getPipelineRegistry()->getPipeline(pInfo);
     }
 
     void ImGuiRenderer::createDescriptorSet() {
@@ -86,13 +83,12 @@ namespace Yare::Graphics {
         m_Font = Image::createTexture2D(texWidth, texHeight, VK_FORMAT_R8G8B8A8_UNORM, fontData);
 
         m_DescriptorSet = new DescriptorSet();
-        m_DescriptorSet->init({m_Pipeline, 1});
+        m_DescriptorSet->init({m_Pipeline.get()});
 
         std::vector<BufferInfo> bufferInfos = {};
-        BufferInfo bInfo;
+        BufferInfo bInfo = {};
         bInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         bInfo.binding = 2;
-        bInfo.descriptorCount = 1;
         bInfo.imageSampler = m_Font->getSampler();
         bInfo.imageView = m_Font->getImageView();
         bufferInfos.push_back(bInfo);
@@ -110,19 +106,83 @@ namespace Yare::Graphics {
         ImGui::Text(fpsStr.c_str());
         ImGui::Checkbox("Render models", &GlobalSettings::instance()->displayModels);
         ImGui::Checkbox("Display background", &GlobalSettings::instance()->displayBackground);
+        ImGui::Checkbox("Display terrain", &GlobalSettings::instance()->displayTerrain);
+        ImGui::SliderInt("Texture budget", &GlobalSettings::instance()->textureBudgetMiB, 16, 2048, "%d MiB");
+
+        auto presentMode = static_cast<int>(GlobalSettings::instance()->presentMode);
+        if (ImGui::Combo("Present mode", &presentMode, "Low latency\0Smooth\0Throughput\0\0")) {
+            GlobalSettings::instance()->presentMode = static_cast<PresentMode>(presentMode);
+        }
+        auto& framePacing = GlobalSettings::instance()->framePacing[presentMode];
+        // Every change recreates the swapchain, so it is only applied once the slider is released
+        if (!m_EditingImageCount) {
+            m_ImageCount = framePacing.imageCount;
+        }
+        ImGui::SliderInt("Swapchain images", &m_ImageCount, 2, 4);
+        m_EditingImageCount = ImGui::IsItemActive();
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            framePacing.imageCount = m_ImageCount;
+        }
+        ImGui::SliderFloat("Target frame time", &framePacing.targetFrameTimeMs, 0.0f, 33.3f, "%.1f ms");
+
+        if (ImGui::CollapsingHeader("Frame statistics")) {
+            const auto& statistics = Application::getAppInstance()->getFrameStatistics();
+            const char* names[] = {"CPU", "GPU", "Present"};
+            for (int i = 0; i < static_cast<int>(FrameMetric::Count); i++) {
+                auto summary = statistics.getSummary(static_cast<FrameMetric>(i));
+                ImGui::Text("%-8s p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f ms", names[i],
+                            summary.p50, summary.p95, summary.p99, summary.max);
+            }
+            ImGui::Text("Stutters: %u in the last %u frames, %llu in total, last %.1f ms",
+                        statistics.getWindowStutterCount(), statistics.getWindowSize(),
+                        static_cast<unsigned long long>(statistics.getStutterCount()), statistics.getLastStutter());
+        }
+
+        // Timings lag a couple of frames behind, they are read once the frame has completed
+        if (ImGui::CollapsingHeader("GPU timings")) {
+            const auto& profiler = VulkanContext::getContext()->getGpuProfiler();
+            if (!profiler->isSupported()) {
+                ImGui::Text("Timestamps are not supported");
+            }
+            for (const auto& timing : profiler->getResults()) {
+                ImGui::Text("%*s%s: %.3f ms", static_cast<int>(timing.depth * 2), "", timing.name.c_str(), timing.milliseconds);
+            }
+        }
+
+        // Counted while the previous frame was recorded, this overlay included
+        if (ImGui::CollapsingHeader("Render statistics")) {
+            const auto& counters = RenderStatistics::instance()->getLastFrame();
+            for (int i = 0; i < static_cast<int>(RenderCounter::Count); i++) {
+                ImGui::Text("%-20s %llu", getRenderCounterName(static_cast<RenderCounter>(i)),
+                            static_cast<unsigned long long>(counters.values[i]));
+            }
+
+            const auto& profiler = VulkanContext::getContext()->getGpuProfiler();
+            if (!profiler->isPipelineStatisticsSupported()) {
+                ImGui::Text("Pipeline statistics are not supported");
+            } else {
+                ImGui::Checkbox("Pipeline statistics", &GlobalSettings::instance()->pipelineStatistics);
+                if (GlobalSettings::instance()->pipelineStatistics && profiler->hasPipelineStatistics()) {
+                    const auto& statistics = profiler->getPipelineStatistics();
+                    ImGui::Text("%-20s %llu", "Input primitives", static_cast<unsigned long long>(statistics.inputPrimitives));
+                    ImGui::Text("%-20s %llu", "Vertex invocations", static_cast<unsigned long long>(statistics.vertexInvocations));
+                    ImGui::Text("%-20s %llu", "Clipping primitives", static_cast<unsigned long long>(statistics.clippingPrimitives));
+                    ImGui::Text("%-20s %llu", "Fragment invocations", static_cast<unsigned long long>(statistics.fragmentInvocations));
+                }
+            }
+        }
         ImGui::End();
         postFrame();
-        updateBuffers();
+        updateBuffers(VulkanContext::getContext()->getCurrentFrame());
     }
 
     void ImGuiRenderer::present(CommandBuffer* commandBuffer){
+        if (!m_Pipeline->isReady()) {
+            return;
+        }
         ImGuiIO& io = ImGui::GetIO();
 
-        vkCmdBindDescriptorSets(commandBuffer->getCommandBuffer(),
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                m_Pipeline->getPipelineLayout(),
-                                0, 1, &m_DescriptorSet->getDescriptorSet(0),
-                                0, nullptr);
+        m_DescriptorSet->bind(*commandBuffer);
 
         m_Pipeline->setActive(*commandBuffer);
 
@@ -138,7 +198,7 @@ namespace Yare::Graphics {
         m_PushConstBlock.scale = glm::vec2(2.0f / io.DisplaySize.x, 2.0f / io.DisplaySize.y);
         vkCmdPushConstants(commandBuffer->getCommandBuffer(),
                            m_Pipeline->getPipelineLayout(),
-                           VK_SHADER_STAGE_VERTEX_BIT, 0,
+                           m_Pipeline->getPushConstantRange().stageFlags, 0,
                            sizeof(PushConstBlock), &m_PushConstBlock);
 
         // Render commands
@@ -146,9 +206,10 @@ namespace Yare::Graphics {
         int32_t vertexOffset = 0;
         int32_t indexOffset = 0;
 
-        if (imDrawData->CmdListsCount > 0) {
-            m_IndexBuffer->bindIndex(commandBuffer, VK_INDEX_TYPE_UINT16);
-            m_VertexBuffer->bindVertex(commandBuffer, 0);
+        auto frame = VulkanContext::getContext()->getCurrentFrame();
+        if (imDrawData->CmdListsCount > 0 && m_IndexBuffers[frame] && m_VertexBuffers[frame]) {
+            m_IndexBuffers[frame]->bindIndex(commandBuffer, VK_INDEX_TYPE_UINT16);
+            m_VertexBuffers[frame]->bindVertex(commandBuffer, 0);
 
             for (int32_t i = 0; i < imDrawData->CmdListsCount; i++) {
                 const ImDrawList* cmd_list = imDrawData->CmdLists[i];
@@ -167,6 +228,7 @@ namespace Yare::Graphics {
                                      indexOffset,
                                      vertexOffset,
                                      0);
+                    RenderStatistics::instance()->addDraw(pcmd->ElemCount, 1);
                     indexOffset += pcmd->ElemCount;
                 }
                 vertexOffset += cmd_list->VtxBuffer.Size;
@@ -174,13 +236,9 @@ namespace Yare::Graphics {
         }
     }
 
-    void ImGuiRenderer::onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight){
-        // Cleanup
-        {
-            delete m_Font;
-            delete m_Pipeline;
-        }
-        init(renderPass, newWidth, newHeight);
+    void ImGuiRenderer::onResize(uint32_t newWidth, uint32_t newHeight){
+        // The font and pipeline are size independent, only the projection follows the window
+        ImGui::GetIO().DisplaySize = ImVec2((float)newWidth, (float)newHeight);
     }
 
     void ImGuiRenderer::newFrame() {
@@ -193,7 +251,7 @@ namespace Yare::Graphics {
         ImGui::Render();
     }
 
-    void ImGuiRenderer::updateBuffers() {
+    void ImGuiRenderer::updateBuffers(uint32_t frame) {
         ImDrawData* imDrawData = ImGui::GetDrawData();
 
         VkDeviceSize vertexBufferSize = imDrawData->TotalVtxCount * sizeof(ImDrawVert);
@@ -203,22 +261,25 @@ namespace Yare::Graphics {
             return;
         }
 
-        if (m_IndexBuffer == nullptr || m_IndexBuffer->getSize() != indexBufferSize) {
-            delete m_IndexBuffer;
-            m_IndexBuffer = new Buffer();
-            m_IndexBuffer->init(BufferUsage::DYNAMIC_INDEX, indexBufferSize, nullptr);
-            m_IndexBuffer->mapMemory(indexBufferSize, 0);
+        // The frame that last used this frame's buffers has completed, they can be replaced right away
+        auto& indexBuffer = m_IndexBuffers[frame];
+        auto& vertexBuffer = m_VertexBuffers[frame];
+        if (indexBuffer == nullptr || indexBuffer->getSize() != indexBufferSize) {
+            delete indexBuffer;
+            indexBuffer = new Buffer();
+            indexBuffer->init(BufferUsage::DYNAMIC_INDEX, indexBufferSize, nullptr);
+            indexBuffer->mapMemory(indexBufferSize, 0);
         }
-        if (m_VertexBuffer == nullptr || m_VertexBuffer->getSize() != vertexBufferSize) {
-            delete m_VertexBuffer;
-            m_VertexBuffer = new Buffer();
-            m_VertexBuffer->init(BufferUsage::DYNAMIC_VERTEX, vertexBufferSize, nullptr);
-            m_VertexBuffer->mapMemory(vertexBufferSize, 0);
+        if (vertexBuffer == nullptr || vertexBuffer->getSize() != vertexBufferSize) {
+            delete vertexBuffer;
+            vertexBuffer = new Buffer();
+            vertexBuffer->init(BufferUsage::DYNAMIC_VERTEX, vertexBufferSize, nullptr);
+            vertexBuffer->mapMemory(vertexBufferSize, 0);
         }
 
 
-        ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>(m_VertexBuffer->getMappedData());
-        ImDrawIdx* idx_dst = reinterpret_cast<ImDrawIdx*>(m_IndexBuffer->getMappedData());
+        ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>(vertexBuffer->getMappedData());
+        ImDrawIdx* idx_dst = reinterpret_cast<ImDrawIdx*>(indexBuffer->getMappedData());
 
         for (int n = 0; n < imDrawData->CmdListsCount; n++) {
             const ImDrawList* cmd_list = imDrawData->CmdLists[n];
@@ -228,8 +289,9 @@ namespace Yare::Graphics {
             idx_dst += cmd_list->IdxBuffer.Size;
         }
 
-        m_IndexBuffer->flush();
-        m_VertexBuffer->flush();
+        indexBuffer->flush();
+        vertexBuffer->flush();
+        RenderStatistics::instance()->add(RenderCounter::BytesUploaded, vertexBufferSize + indexBufferSize);
     }
 
 }
@@ -17,7 +17,8 @@ namespace Yare::Graphics {
         ~ImGuiRenderer();
         void prepareScene() override;
         void present(CommandBuffer* commandBuffer) override;
-        void onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) override;
+        const char* getName() const override { return "ImGui"; }
+        void onResize(uint32_t newWidth, uint32_t newHeight) override;
 
     private:
         void init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) override;
@@ -25,7 +26,7 @@ namespace Yare::Graphics {
         void createDescriptorSet();
         void newFrame();
         void postFrame();
-        void updateBuffers();
+        void updateBuffers(uint32_t frame);
 
         struct PushConstBlock {
             glm::vec2 scale = {};
@@ -33,10 +34,14 @@ namespace Yare::Graphics {
         } m_PushConstBlock;
 
         Image* m_Font;
-        Pipeline* m_Pipeline;
-        Buffer* m_IndexBuffer = nullptr;
-        Buffer* m_VertexBuffer = nullptr;
+        std::shared_ptr<Pipeline> m_Pipeline;
+        // Refilled every frame, so each frame in flight has its own
+        std::vector<Buffer*> m_IndexBuffers;
+        std::vector<Buffer*> m_VertexBuffers;
         DescriptorSet* m_DescriptorSet;
+        // Value of the swapchain image slider while it is dragged
+        int m_ImageCount = 0;
+        bool m_EditingImageCount = false;
     };
 
 }
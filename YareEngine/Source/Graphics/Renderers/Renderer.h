@@ -25,7 +25,14 @@ namespace Yare::Graphics {
 
         virtual void prepareScene() = 0;
         virtual void present(CommandBuffer* commandBuffer) = 0;
-        virtual void onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) = 0;
+        // Recorded after the render pass has ended, for barriers that can't be inside it
+        virtual void endFrame(CommandBuffer* commandBuffer) {}
+        // Pipelines take their viewport dynamically, so only size dependent state has to be updated here
+        virtual void onResize(uint32_t newWidth, uint32_t newHeight) {}
+        // Shown in the GPU timings
+        virtual const char* getName() const = 0;
+        // Appends the entities the renderer draws, always in the order they were created
+        virtual void getEntities(std::vector<Entity*>& entities) const {}
 
     protected:
         virtual void init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) = 0;
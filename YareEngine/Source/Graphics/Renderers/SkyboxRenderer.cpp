@@ -3,6 +3,8 @@
 #include "Application/Application.h"
 #include "Utilities/Logger.h"
 #include "Graphics/Vulkan/Utilities.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Graphics/MeshFactory.h"
 #include "Core/Memory.h"
 
@@ -29,17 +31,20 @@ namespace Yare::Graphics {
     }
 
     SkyboxRenderer::~SkyboxRenderer() {
-        delete m_Pipeline;
-        delete m_UniformBuffer;
-        delete m_DescriptorSet;
+        for (auto uniformBuffer : m_UniformBuffers) {
+            delete uniformBuffer;
+        }
+        for (auto descriptorSet : m_DescriptorSets) {
+            delete descriptorSet;
+        }
         delete m_SkyboxModel;
     }
 
     void SkyboxRenderer::init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
         m_Material->loadTextures();
-        createGraphicsPipeline(renderPass, windowWidth, windowHeight);
-        prepareUniformBuffer();
-        createDescriptorSet();
+        createGraphicsPipeline(renderPass);
+        prepareUniformBuffers();
+        createDescriptorSets();
     }
 
     void SkyboxRenderer::prepareScene() {
@@ -49,102 +54,81 @@ namespace Yare::Graphics {
 
 
     void SkyboxRenderer::present(CommandBuffer* commandBuffer) {
-        if (GlobalSettings::instance()->displayBackground) {
+        if (GlobalSettings::instance()->displayBackground && m_Pipeline->isReady()) {
+            auto frame = VulkanContext::getContext()->getCurrentFrame();
             for (auto command : m_CommandQueue) {
-                vkCmdBindDescriptorSets(commandBuffer->getCommandBuffer(),
-                                        VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline->getPipelineLayout(),
-                                        0, 1, &m_DescriptorSet->getDescriptorSet(0), 0 , nullptr);
+                updateUniformBuffer(frame);
+                m_DescriptorSets[frame]->bind(*commandBuffer);
                 command.entity->getMesh()->getVertexBuffer()->bindVertex(commandBuffer, 0);
                 command.entity->getMesh()->getIndexBuffer()->bindIndex(commandBuffer, VK_INDEX_TYPE_UINT32);
                 m_Pipeline->setActive(*commandBuffer);
 
                 auto indexCount = command.entity->getMesh()->getIndexBuffer()->getSize() / sizeof(uint32_t);
                 vkCmdDrawIndexed(commandBuffer->getCommandBuffer(), static_cast<uint32_t>(indexCount), 1, 0, 0, 0);
-                updateUniformBuffer(0);
+                RenderStatistics::instance()->addDraw(static_cast<uint32_t>(indexCount), 1);
             }
         }
     }
 
-    void SkyboxRenderer::onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) {
-        // Cleanup
-        {
-            delete m_Pipeline;
-            delete m_UniformBuffer;
-        }
-        createGraphicsPipeline(renderPass, newWidth, newHeight);
-        prepareUniformBuffer();
-        createDescriptorSet();
-    }
-
-    void SkyboxRenderer::createGraphicsPipeline(RenderPass* renderPass, uint32_t width, uint32_t height) {
-        Shader skyboxShader("../Res/Shaders", "skybox.shader");
+    void SkyboxRenderer::createGraphicsPipeline(RenderPass* renderPass) {
         PipelineInfo pipelineInfo = {};
-        pipelineInfo.shader = &skyboxShader;
+        pipelineInfo.shaderPath = "../Res/Shaders";
+        pipelineInfo.shaderName = "skybox.shader";
 
         pipelineInfo.renderpass = renderPass;
         pipelineInfo.cullMode = VK_CULL_MODE_FRONT_BIT;
         pipelineInfo.depthTestEnable = VK_FALSE;
         pipelineInfo.depthWriteEnable = VK_FALSE;
-        pipelineInfo.maxObjects = 2;
 
         // location, binding, format, offset
         VkVertexInputAttributeDescription pos = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos)};
         pipelineInfo.vertexInputAttributes = { pos };
 
-        // binding, descriptorType, descriptorCount, stageFlags, pImmuatbleSamplers
-        VkDescriptorSetLayoutBinding viewProj = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1,
-                                                 VK_SHADER_STAGE_VERTEX_BIT, nullptr};
-        VkDescriptorSetLayoutBinding sampler = {1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
-                                                VK_SHADER_STAGE_FRAGMENT_BIT, nullptr};
-        pipelineInfo.layoutBindings = {viewProj, sampler};
-        pipelineInfo.width = width;
-        pipelineInfo.height = height;
-        pipelineInfo.pushConstants = {VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(int)};
         pipelineInfo.bindingDescription = {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX};
+        pipelineInfo.pushDescriptors = true;
 
-        m_Pipeline = new Pipeline();
-        m_Pipeline->init(pipelineInfo);
+        m_Pipeline = VulkanContext::getContext()->getPipelineRegistry()->getPipeline(pipelineInfo);
 
     }
 
-    void SkyboxRenderer::createDescriptorSet(){
+    void SkyboxRenderer::createDescriptorSets(){
         DescriptorSetInfo descriptorSetInfo;
-        descriptorSetInfo.descriptorSetCount = 1;
-        descriptorSetInfo.pipeline = m_Pipeline;
-
-        m_DescriptorSet = new DescriptorSet();
-        m_DescriptorSet->init(descriptorSetInfo);
-
-
-        std::vector<BufferInfo> bufferInfos = {};
-        BufferInfo viewBufferInfo = {};
-        viewBufferInfo.buffer = m_UniformBuffer->getBuffer();
-        viewBufferInfo.offset = 0;
-        viewBufferInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        viewBufferInfo.size = sizeof(UniformVS);
-        viewBufferInfo.binding = 0;
-        viewBufferInfo.imageSampler = nullptr;
-        viewBufferInfo.imageView = nullptr;
-        viewBufferInfo.descriptorCount = 1;
-        bufferInfos.push_back(viewBufferInfo);
-
-        BufferInfo imageBufferInfo = {};
-        imageBufferInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        imageBufferInfo.binding = 1;
-        imageBufferInfo.descriptorCount = 1;
-        imageBufferInfo.imageSampler = m_SkyboxModel->getMaterial()->getTextureImage()->getSampler();
-        imageBufferInfo.imageView = m_SkyboxModel->getMaterial()->getTextureImage()->getImageView();
-        bufferInfos.push_back(imageBufferInfo);
-
-        m_DescriptorSet->update(bufferInfos);
+        descriptorSetInfo.pipeline = m_Pipeline.get();
+
+        for (auto uniformBuffer : m_UniformBuffers) {
+            m_DescriptorSets.push_back(new DescriptorSet());
+            m_DescriptorSets.back()->init(descriptorSetInfo);
+
+            std::vector<BufferInfo> bufferInfos = {};
+            BufferInfo viewBufferInfo = {};
+            viewBufferInfo.buffer = uniformBuffer->getBuffer();
+            viewBufferInfo.offset = 0;
+            viewBufferInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            viewBufferInfo.size = sizeof(UniformVS);
+            viewBufferInfo.binding = 0;
+            viewBufferInfo.imageSampler = nullptr;
+            viewBufferInfo.imageView = nullptr;
+            bufferInfos.push_back(viewBufferInfo);
+
+            BufferInfo imageBufferInfo = {};
+            imageBufferInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            imageBufferInfo.binding = 1;
+            imageBufferInfo.imageSampler = m_SkyboxModel->getMaterial()->getTextureImage()->getSampler();
+            imageBufferInfo.imageView = m_SkyboxModel->getMaterial()->getTextureImage()->getImageView();
+            bufferInfos.push_back(imageBufferInfo);
+
+            m_DescriptorSets.back()->update(bufferInfos);
+        }
     }
 
-    void SkyboxRenderer::prepareUniformBuffer() {
+    void SkyboxRenderer::prepareUniformBuffers() {
         VkDeviceSize viewBufferSize = sizeof(UniformVS);
-        m_UniformBuffer = new Buffer(BufferUsage::UNIFORM, viewBufferSize, nullptr);
+        for (uint32_t i = 0; i < VulkanContext::getContext()->getMaxFramesInFlight(); i++) {
+            m_UniformBuffers.push_back(new Buffer(BufferUsage::UNIFORM, viewBufferSize, nullptr));
+        }
     }
 
-    void SkyboxRenderer::updateUniformBuffer(uint32_t index) {
+    void SkyboxRenderer::updateUniformBuffer(uint32_t frame) {
         UniformVS skyboxVS = {};
 
         skyboxVS.view = Application::getAppInstance()->getWindow()->getCamera()->getViewMatrix();
@@ -153,6 +137,6 @@ namespace Yare::Graphics {
 
         skyboxVS.view[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
-        m_UniformBuffer->setData(sizeof(skyboxVS), &skyboxVS);
+        m_UniformBuffers[frame]->setData(sizeof(skyboxVS), &skyboxVS);
     }
 }
@@ -18,22 +18,23 @@ namespace Yare::Graphics {
 
         void prepareScene() override;
         void present(CommandBuffer* commandBuffer) override;
-        void onResize(RenderPass* renderPass, uint32_t newWidth, uint32_t newHeight) override;
+        const char* getName() const override { return "Skybox"; }
 
     private:
         void init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) override;
-        void createGraphicsPipeline(RenderPass* renderPass, uint32_t width, uint32_t height);
-        void createDescriptorSet();
-        void prepareUniformBuffer();
-        void updateUniformBuffer(uint32_t index);
+        void createGraphicsPipeline(RenderPass* renderPass);
+        void createDescriptorSets();
+        void prepareUniformBuffers();
+        void updateUniformBuffer(uint32_t frame);
 
     private:
         std::shared_ptr<Mesh> m_CubeMesh;
         std::shared_ptr<Material> m_Material;
         Entity* m_SkyboxModel;
-        Pipeline* m_Pipeline;
-        DescriptorSet* m_DescriptorSet;
-        Buffer* m_UniformBuffer;
+        std::shared_ptr<Pipeline> m_Pipeline;
+        // One of each per frame in flight, the GPU may still read the previous frame's
+        std::vector<Buffer*> m_UniformBuffers;
+        std::vector<DescriptorSet*> m_DescriptorSets;
     };
 }
 
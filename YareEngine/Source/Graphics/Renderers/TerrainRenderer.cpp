@@ -0,0 +1,170 @@
+#include "Graphics/Renderers/TerrainRenderer.h"
+#include "Application/GlobalSettings.h"
+#include "Application/Application.h"
+#include "Utilities/Logger.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
+#include "Graphics/MeshFactory.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Yare::Graphics {
+
+    TerrainRenderer::TerrainRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight,
+                                     uint32_t gridSize) {
+        VirtualTextureInfo virtualTextureInfo;
+        virtualTextureInfo.filePath = "../Res/Textures/chalet.yvt";
+        virtualTextureInfo.sourcePath = "../Res/Textures/chalet.jpg";
+        m_VirtualTexture = new VirtualTexture(virtualTextureInfo);
+
+        m_GridSize = std::max(gridSize, 2u);
+        m_TerrainMesh = std::shared_ptr<Mesh>(createQuadPlane(m_GridSize, m_GridSize));
+        m_Transform.setTranslation(-m_GridSize / 2.0f, -1.0f, -m_GridSize / 2.0f);
+
+        init(renderPass, windowWidth, windowHeight);
+    }
+
+    TerrainRenderer::~TerrainRenderer() {
+        for (auto uniformBuffer : m_UniformBuffers) {
+            delete uniformBuffer;
+        }
+        for (auto descriptorSet : m_DescriptorSets) {
+            delete descriptorSet;
+        }
+        delete m_VirtualTexture;
+    }
+
+    bool TerrainRenderer::isSupported() {
+        if (!Devices::instance()->getEnabledFeatures().fragmentStoresAndAtomics) {
+            return false;
+        }
+        return std::ifstream("../Res/Shaders/terrainVert.spv").good() &&
+               std::ifstream("../Res/Shaders/terrainFrag.spv").good();
+    }
+
+    void TerrainRenderer::init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) {
+        m_PushConstBlock.terrainParams = glm::vec4(static_cast<float>(m_GridSize - 1), 0.0f, 0.0f, 0.0f);
+        m_PushConstBlock.virtualTexture = m_VirtualTexture->getShaderParams();
+
+        createGraphicsPipeline(renderPass);
+        prepareUniformBuffers();
+        createDescriptorSets();
+    }
+
+    void TerrainRenderer::prepareScene() {
+        // The last frame with this index has been waited on, its feedback is complete. The uploads are
+        // ordered after the frame still in flight, which keeps sampling the cache until it finishes.
+        m_VirtualTexture->processFeedback(VulkanContext::getContext()->getCurrentFrame());
+        m_VirtualTexture->processUploads();
+    }
+
+    void TerrainRenderer::present(CommandBuffer* commandBuffer) {
+        if (GlobalSettings::instance()->displayTerrain && m_Pipeline->isReady()) {
+            auto frame = VulkanContext::getContext()->getCurrentFrame();
+            updateUniformBuffer(frame);
+            m_Pipeline->setActive(*commandBuffer);
+
+            vkCmdPushConstants(commandBuffer->getCommandBuffer(), m_Pipeline->getPipelineLayout(),
+                               m_Pipeline->getPushConstantRange().stageFlags,
+                               0, sizeof(PushConstBlock), &m_PushConstBlock);
+            m_DescriptorSets[frame]->bind(*commandBuffer);
+
+            m_TerrainMesh->getVertexBuffer()->bindVertex(commandBuffer, 0);
+            m_TerrainMesh->getIndexBuffer()->bindIndex(commandBuffer, VK_INDEX_TYPE_UINT32);
+
+            auto indexCount = m_TerrainMesh->getIndexBuffer()->getSize() / sizeof(uint32_t);
+            vkCmdDrawIndexed(commandBuffer->getCommandBuffer(), static_cast<uint32_t>(indexCount), 1, 0, 0, 0);
+            RenderStatistics::instance()->addDraw(static_cast<uint32_t>(indexCount), 1);
+        }
+    }
+
+    void TerrainRenderer::endFrame(CommandBuffer* commandBuffer) {
+        m_VirtualTexture->recordFeedbackBarrier(*commandBuffer);
+    }
+
+    void TerrainRenderer::createGraphicsPipeline(RenderPass* renderPass) {
+        PipelineInfo pipelineInfo = {};
+        pipelineInfo.shaderPath = "../Res/Shaders";
+        pipelineInfo.shaderName = "terrain.shader";
+
+        pipelineInfo.renderpass = renderPass;
+        pipelineInfo.cullMode = VK_CULL_MODE_NONE;
+        pipelineInfo.depthTestEnable = VK_TRUE;
+        pipelineInfo.depthWriteEnable = VK_TRUE;
+
+        // location, binding, format, offset
+        VkVertexInputAttributeDescription pos = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos)};
+        pipelineInfo.vertexInputAttributes = { pos };
+
+        pipelineInfo.bindingDescription = {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX};
+        pipelineInfo.pushDescriptors = true;
+
+        m_Pipeline = VulkanContext::getContext()->getPipelineRegistry()->getPipeline(pipelineInfo);
+    }
+
+    void TerrainRenderer::createDescriptorSets() {
+        DescriptorSetInfo descriptorSetInfo;
+        descriptorSetInfo.pipeline = m_Pipeline.get();
+
+        for (uint32_t frame = 0; frame < m_UniformBuffers.size(); frame++) {
+            m_DescriptorSets.push_back(new DescriptorSet());
+            m_DescriptorSets.back()->init(descriptorSetInfo);
+
+            std::vector<BufferInfo> bufferInfos = {};
+            BufferInfo mvpBufferInfo = {};
+            mvpBufferInfo.buffer = m_UniformBuffers[frame]->getBuffer();
+            mvpBufferInfo.offset = 0;
+            mvpBufferInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            mvpBufferInfo.size = sizeof(UniformBufferObject);
+            mvpBufferInfo.binding = 0;
+            mvpBufferInfo.imageSampler = nullptr;
+            mvpBufferInfo.imageView = nullptr;
+            bufferInfos.push_back(mvpBufferInfo);
+
+            // The page table and cache are updated in place, so these never have to be rewritten
+            BufferInfo pageTableInfo = {};
+            pageTableInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            pageTableInfo.binding = 1;
+            pageTableInfo.imageSampler = m_VirtualTexture->getPageTable()->getSampler();
+            pageTableInfo.imageView = m_VirtualTexture->getPageTable()->getImageView();
+            bufferInfos.push_back(pageTableInfo);
+
+            BufferInfo tileCacheInfo = {};
+            tileCacheInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            tileCacheInfo.binding = 2;
+            tileCacheInfo.imageSampler = m_VirtualTexture->getTileCache()->getSampler();
+            tileCacheInfo.imageView = m_VirtualTexture->getTileCache()->getImageView();
+            bufferInfos.push_back(tileCacheInfo);
+
+            BufferInfo feedbackInfo = {};
+            feedbackInfo.buffer = m_VirtualTexture->getFeedbackBuffer(frame)->getBuffer();
+            feedbackInfo.offset = 0;
+            feedbackInfo.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            feedbackInfo.size = m_VirtualTexture->getFeedbackSize();
+            feedbackInfo.binding = 3;
+            feedbackInfo.imageSampler = nullptr;
+            feedbackInfo.imageView = nullptr;
+            bufferInfos.push_back(feedbackInfo);
+
+            m_DescriptorSets.back()->update(bufferInfos);
+        }
+    }
+
+    void TerrainRenderer::prepareUniformBuffers() {
+        for (uint32_t i = 0; i < VulkanContext::getContext()->getMaxFramesInFlight(); i++) {
+            m_UniformBuffers.push_back(new Buffer(BufferUsage::UNIFORM, sizeof(UniformBufferObject), nullptr));
+        }
+    }
+
+    void TerrainRenderer::updateUniformBuffer(uint32_t frame) {
+        UniformBufferObject terrainUbo = {};
+        terrainUbo.model = m_Transform.getMatrix();
+        terrainUbo.view = Application::getAppInstance()->getWindow()->getCamera()->getViewMatrix();
+        terrainUbo.proj = Application::getAppInstance()->getWindow()->getCamera()->getProjectionMatrix();
+        terrainUbo.proj[1][1] *= -1;
+
+        m_UniformBuffers[frame]->setData(sizeof(terrainUbo), &terrainUbo);
+    }
+}
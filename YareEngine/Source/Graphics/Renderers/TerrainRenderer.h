@@ -0,0 +1,57 @@
+#ifndef YARE_TERRAIN_RENDERER_H
+#define YARE_TERRAIN_RENDERER_H
+
+#include "Graphics/Renderers/Renderer.h"
+
+#include "Graphics/Vulkan/Pipeline.h"
+#include "Graphics/Vulkan/Buffer.h"
+#include "Graphics/Vulkan/DescriptorSet.h"
+#include "Graphics/Streaming/VirtualTexture.h"
+
+#include <memory>
+
+namespace Yare::Graphics {
+
+    // Draws a large ground plane textured from a virtual texture, only the pages that are
+    // actually sampled are ever loaded.
+    class TerrainRenderer : public Renderer {
+    public:
+        // The terrain is gridSize quads per side, at least 2
+        TerrainRenderer(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight, uint32_t gridSize);
+        ~TerrainRenderer() override;
+
+        void prepareScene() override;
+        void present(CommandBuffer* commandBuffer) override;
+        void endFrame(CommandBuffer* commandBuffer) override;
+        const char* getName() const override { return "Terrain"; }
+
+        // Feedback needs fragment shader stores, and the terrain shaders have to be compiled
+        static bool isSupported();
+
+    private:
+        void init(RenderPass* renderPass, uint32_t windowWidth, uint32_t windowHeight) override;
+        void createGraphicsPipeline(RenderPass* renderPass);
+        void createDescriptorSets();
+        void prepareUniformBuffers();
+        void updateUniformBuffer(uint32_t frame);
+
+    private:
+        struct PushConstBlock {
+            // x = size of the terrain in world units
+            glm::vec4 terrainParams;
+            VirtualTextureParams virtualTexture;
+        } m_PushConstBlock;
+
+        // Quads per side of the terrain mesh
+        uint32_t m_GridSize;
+        std::shared_ptr<Mesh> m_TerrainMesh;
+        Transform m_Transform;
+        VirtualTexture* m_VirtualTexture;
+        std::shared_ptr<Pipeline> m_Pipeline;
+        // Indexed by the frame being recorded
+        std::vector<Buffer*> m_UniformBuffers;
+        std::vector<DescriptorSet*> m_DescriptorSets;
+    };
+}
+
+#endif // YARE_TERRAIN_RENDERER_H
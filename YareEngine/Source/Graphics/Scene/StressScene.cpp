@@ -0,0 +1,61 @@
+#include "Graphics/Scene/StressScene.h"
+#include "Graphics/MeshFactory.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Yare::Graphics {
+
+    namespace {
+        const char* s_TexturePaths[] = {
+            "../Res/Textures/viking_room.png",
+            "../Res/Textures/crate.png",
+            "../Res/Textures/sprite.jpg",
+            "../Res/Textures/tile.png",
+        };
+
+        // The engine's output is specified by the standard, unlike the distributions, so scenes match
+        // between platforms
+        float random01(std::mt19937& engine) {
+            return static_cast<float>(engine() / 4294967296.0);
+        }
+    }
+
+    void createStressScene(const StressSceneInfo& info, std::vector<std::shared_ptr<Mesh>>& meshes,
+                           std::vector<std::shared_ptr<Material>>& materials,
+                           std::vector<std::shared_ptr<Entity>>& entities) {
+        auto meshCount = std::max(info.meshCount, 1u);
+        auto textureCount = std::max(info.textureCount, 1u);
+
+        for (uint32_t i = 0; i < meshCount; i++) {
+            // Alternate between cubes and small planes of growing size
+            if (i % 2 == 0) {
+                meshes.emplace_back(createCube(0.5f + 0.05f * static_cast<float>(i / 2 % 16)));
+            } else {
+                size_t size = 1 + i / 2 % 4;
+                meshes.emplace_back(createQuadPlane(size, size));
+            }
+        }
+
+        auto pathCount = sizeof(s_TexturePaths) / sizeof(s_TexturePaths[0]);
+        for (uint32_t i = 0; i < textureCount; i++) {
+            // Every material loads its own image, even from the same file
+            materials.push_back(std::make_shared<Material>(s_TexturePaths[i % pathCount]));
+        }
+
+        std::mt19937 engine(info.seed);
+        auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(info.entityCount))));
+        auto offset = (static_cast<float>(side) - 1.0f) * STRESS_SCENE_SPACING / 2.0f;
+        for (uint32_t i = 0; i < info.entityCount; i++) {
+            glm::vec3 translation(static_cast<float>(i % side) * STRESS_SCENE_SPACING - offset, 0.0f,
+                                  static_cast<float>(i / side) * STRESS_SCENE_SPACING - offset);
+            glm::vec3 rotation(0.0f, random01(engine) * glm::two_pi<float>(), 0.0f);
+            glm::vec3 scale(0.75f + random01(engine) * 0.5f);
+            entities.push_back(std::make_shared<Entity>(meshes[i % meshCount], materials[i % textureCount],
+                                                        Transform{translation, rotation, scale}));
+        }
+    }
+}
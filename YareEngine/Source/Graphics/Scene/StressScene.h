@@ -0,0 +1,34 @@
+#ifndef YARE_STRESS_SCENE_H
+#define YARE_STRESS_SCENE_H
+
+#include "Graphics/Scene/Entity.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // A generated scene for repeatable benchmarks, the same info always gives the same scene
+    struct StressSceneInfo {
+        // 0 renders the regular scene
+        uint32_t entityCount = 0;
+        // Meshes and textures that are shared out over the entities, each has its own buffers or image
+        uint32_t meshCount = 4;
+        uint32_t textureCount = 4;
+        // Quads per side of the terrain
+        uint32_t terrainSize = 256;
+        uint32_t seed = 1;
+    };
+
+    // Lays the entities out on a square grid around the origin with seeded rotations, entity i uses
+    // mesh i % meshCount and texture i % textureCount
+    void createStressScene(const StressSceneInfo& info, std::vector<std::shared_ptr<Mesh>>& meshes,
+                           std::vector<std::shared_ptr<Material>>& materials,
+                           std::vector<std::shared_ptr<Entity>>& entities);
+
+    // Distance between two neighbouring entities of the grid
+    constexpr float STRESS_SCENE_SPACING = 2.5f;
+}
+
+#endif // YARE_STRESS_SCENE_H
@@ -0,0 +1,27 @@
+#include "Graphics/Streaming/MipChain.h"
+
+#include <algorithm>
+
+namespace Yare::Graphics {
+
+    void downsampleRGBA8(const std::vector<unsigned char>& src, uint32_t width, uint32_t height,
+                         std::vector<unsigned char>& dst) {
+        uint32_t dstWidth = std::max(width / 2, 1u);
+        uint32_t dstHeight = std::max(height / 2, 1u);
+        dst.resize(static_cast<size_t>(dstWidth) * dstHeight * 4);
+
+        for (uint32_t y = 0; y < dstHeight; y++) {
+            uint32_t y0 = std::min(y * 2, height - 1);
+            uint32_t y1 = std::min(y * 2 + 1, height - 1);
+            for (uint32_t x = 0; x < dstWidth; x++) {
+                uint32_t x0 = std::min(x * 2, width - 1);
+                uint32_t x1 = std::min(x * 2 + 1, width - 1);
+                for (uint32_t c = 0; c < 4; c++) {
+                    uint32_t sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c] +
+                                   src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+                    dst[(y * dstWidth + x) * 4 + c] = static_cast<unsigned char>(sum / 4);
+                }
+            }
+        }
+    }
+}
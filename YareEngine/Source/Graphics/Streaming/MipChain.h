@@ -0,0 +1,14 @@
+#ifndef YARE_MIP_CHAIN_H
+#define YARE_MIP_CHAIN_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Halves an RGBA8 image with a box filter, odd edges reuse the last row/column
+    void downsampleRGBA8(const std::vector<unsigned char>& src, uint32_t width, uint32_t height,
+                         std::vector<unsigned char>& dst);
+}
+
+#endif // YARE_MIP_CHAIN_H
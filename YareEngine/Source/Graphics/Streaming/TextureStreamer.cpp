@@ -0,0 +1,336 @@
+#include "Graphics/Streaming/TextureStreamer.h"
+#include "Graphics/Streaming/MipChain.h"
+#include "Utilities/Logger.h"
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace Yare::Graphics {
+
+    namespace {
+        const uint32_t MIP_CHAIN_MAGIC = 0x50494D59; // "YMIP"
+        const uint32_t MIP_CHAIN_VERSION = 1;
+
+        // Followed by every mip of the texture as RGBA8, largest first
+        struct MipChainHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t width;
+            uint32_t height;
+            uint32_t mipCount;
+        };
+    }
+
+    TextureStreamer::TextureStreamer(const TextureStreamerInfo& info)
+        : m_Info(info) {
+        m_Worker = std::thread(&TextureStreamer::workerLoop, this);
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            m_Running = false;
+        }
+        m_RequestCondition.notify_all();
+        if (m_Worker.joinable()) {
+            m_Worker.join();
+        }
+    }
+
+    void TextureStreamer::registerMaterial(const std::shared_ptr<Material>& material) {
+        // Cube maps are sampled in every direction at once, there is nothing to gain from streaming them
+        if (material->getType() != MaterialTexType::Texture2D) {
+            material->loadTextures();
+            return;
+        }
+
+        auto texture = std::make_unique<StreamedTexture>();
+        texture->material = material.get();
+        texture->filePath = material->getFilePaths().empty() ? "../Res/Textures/default.jpg"
+                                                             : material->getFilePaths()[0];
+
+        int width, height, channels;
+        if (!stbi_info(texture->filePath.c_str(), &width, &height, &channels)) {
+            YZ_CRITICAL("TextureStreamer failed to read the header of texture: " + texture->filePath);
+        }
+        texture->width = static_cast<uint32_t>(width);
+        texture->height = static_cast<uint32_t>(height);
+        texture->mipCount = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+
+        while (texture->tailMip + 1 < texture->mipCount &&
+               std::max(texture->width >> texture->tailMip, texture->height >> texture->tailMip) > m_Info.residentTailSize) {
+            texture->tailMip++;
+        }
+
+        texture->chainPath = texture->filePath + ".ymip";
+        std::ifstream chainFile;
+        if (!openMipChainFile(*texture, chainFile)) {
+            YZ_INFO("Building mip chain " + texture->chainPath);
+            std::vector<unsigned char> pixels;
+            if (!decodeMipChain(texture->filePath, pixels)) {
+                YZ_CRITICAL("TextureStreamer failed to load texture: " + texture->filePath);
+            }
+
+            MipChainHeader header = {MIP_CHAIN_MAGIC, MIP_CHAIN_VERSION, texture->width, texture->height, texture->mipCount};
+            std::ofstream output(texture->chainPath, std::ios::binary | std::ios::trunc);
+            output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            output.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+            output.close();
+            if (!output) {
+                YZ_WARN("TextureStreamer could not write " + texture->chainPath + ", every mip is kept in memory");
+                std::remove(texture->chainPath.c_str());
+                texture->chainPixels = std::move(pixels);
+            }
+        }
+
+        if (!readMipChain(*texture, texture->tailMip, texture->tailPixels)) {
+            YZ_CRITICAL("TextureStreamer failed to read the mip chain of texture: " + texture->filePath);
+        }
+
+        uint32_t tailWidth = std::max(texture->width >> texture->tailMip, 1u);
+        uint32_t tailHeight = std::max(texture->height >> texture->tailMip, 1u);
+        material->setTextureImage(Image::createTexture2DMipChain(tailWidth, tailHeight, VK_FORMAT_R8G8B8A8_SRGB,
+                                                                 texture->tailPixels.data(),
+                                                                 texture->mipCount - texture->tailMip));
+        texture->residentMip = texture->tailMip;
+        texture->targetMip = texture->tailMip;
+        texture->desiredMip = texture->tailMip;
+
+        size_t tailBytes = chainBytes(*texture, texture->tailMip);
+        m_CommittedBytes += tailBytes;
+        m_ResidentBytes += tailBytes;
+
+        m_Textures[material.get()] = std::move(texture);
+    }
+
+    void TextureStreamer::updateResidency(const CommandQueue& commandQueue, const Camera& camera,
+                                          uint32_t screenHeight) {
+        m_FrameIndex++;
+
+        for (auto& [material, texture] : m_Textures) {
+            texture->desiredMip = texture->tailMip;
+        }
+
+        for (const auto& command : commandQueue) {
+            auto found = m_Textures.find(command.entity->getMaterial().get());
+            if (found == m_Textures.end()) {
+                continue;
+            }
+            auto& texture = *found->second;
+            texture.desiredMip = std::min(texture.desiredMip, estimateMip(texture, *command.entity, camera, screenHeight));
+            texture.lastUsedFrame = m_FrameIndex;
+        }
+
+        // Brings the textures back under a budget that has been lowered
+        makeRoom(0, nullptr);
+
+        // Only ever stream towards more detail here, dropping detail is left to the budget
+        for (auto& [material, texture] : m_Textures) {
+            if (texture->desiredMip >= texture->targetMip) {
+                continue;
+            }
+            size_t bytesNeeded = chainBytes(*texture, texture->desiredMip) - chainBytes(*texture, texture->targetMip);
+            if (makeRoom(bytesNeeded, texture.get())) {
+                queueLoad(*texture, texture->desiredMip);
+            }
+        }
+    }
+
+    bool TextureStreamer::processUploads() {
+        std::vector<LoadResult> results;
+        {
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            results.swap(m_Results);
+        }
+
+        bool changed = false;
+        for (auto& result : results) {
+            auto& texture = *result.texture;
+            // A newer load or an eviction has been queued since, this result is stale
+            if (result.baseMip != texture.targetMip) {
+                continue;
+            }
+
+            if (result.pixels.empty()) {
+                YZ_WARN("TextureStreamer failed to stream mip {} of {}", result.baseMip, texture.filePath);
+                m_CommittedBytes -= chainBytes(texture, texture.targetMip);
+                m_CommittedBytes += chainBytes(texture, texture.residentMip);
+                texture.targetMip = texture.residentMip;
+                continue;
+            }
+
+            uint32_t width = std::max(texture.width >> result.baseMip, 1u);
+            uint32_t height = std::max(texture.height >> result.baseMip, 1u);
+            texture.material->setTextureImage(Image::createTexture2DMipChain(width, height, VK_FORMAT_R8G8B8A8_SRGB,
+                                                                             result.pixels.data(),
+                                                                             texture.mipCount - result.baseMip));
+
+            m_ResidentBytes -= chainBytes(texture, texture.residentMip);
+            m_ResidentBytes += chainBytes(texture, result.baseMip);
+            texture.residentMip = result.baseMip;
+            changed = true;
+        }
+        return changed;
+    }
+
+    void TextureStreamer::queueLoad(StreamedTexture& texture, uint32_t baseMip) {
+        m_CommittedBytes -= chainBytes(texture, texture.targetMip);
+        m_CommittedBytes += chainBytes(texture, baseMip);
+        texture.targetMip = baseMip;
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            m_Requests.push_back({&texture, baseMip});
+        }
+        m_RequestCondition.notify_one();
+    }
+
+    void TextureStreamer::evict(StreamedTexture& texture) {
+        m_CommittedBytes -= chainBytes(texture, texture.targetMip);
+        m_CommittedBytes += chainBytes(texture, texture.tailMip);
+        texture.targetMip = texture.tailMip;
+
+        // The tail lives on the CPU, so the eviction goes straight to the result queue
+        std::lock_guard<std::mutex> lock(m_ResultMutex);
+        m_Results.push_back({&texture, texture.tailMip, texture.tailPixels});
+    }
+
+    bool TextureStreamer::makeRoom(size_t bytesNeeded, const StreamedTexture* requester) {
+        while (m_CommittedBytes + bytesNeeded > m_Info.budgetBytes) {
+            // Least recently used texture that has been off screen long enough and holds more than its tail
+            StreamedTexture* victim = nullptr;
+            for (auto& [material, texture] : m_Textures) {
+                if (texture.get() == requester || texture->targetMip >= texture->tailMip ||
+                    texture->lastUsedFrame + m_Info.evictionDelay >= m_FrameIndex) {
+                    continue;
+                }
+                if (!victim || texture->lastUsedFrame < victim->lastUsedFrame) {
+                    victim = texture.get();
+                }
+            }
+            if (!victim) {
+                return false;
+            }
+            evict(*victim);
+        }
+        return true;
+    }
+
+    uint32_t TextureStreamer::estimateMip(const StreamedTexture& texture, const Entity& entity,
+                                          const Camera& camera, uint32_t screenHeight) const {
+        const auto& transform = entity.getTransform();
+        glm::vec3 scale = transform.getScale();
+        float radius = entity.getMesh()->getBoundingRadius() * std::max(scale.x, std::max(scale.y, scale.z));
+        float distance = glm::length(transform.getTranslation() - camera.getTransform().getTranslation());
+
+        // Inside the bounds, the texture could fill the whole screen
+        if (distance <= radius) {
+            return 0;
+        }
+
+        // Projected diameter of the bounding sphere in pixels
+        float projectedSize = radius / (distance * std::tan(glm::radians(camera.getFov()) * 0.5f)) * screenHeight;
+        float texels = static_cast<float>(std::max(texture.width, texture.height));
+        float mip = std::floor(std::log2(texels / std::max(projectedSize, 1.0f)));
+
+        return static_cast<uint32_t>(std::clamp(mip, 0.0f, static_cast<float>(texture.tailMip)));
+    }
+
+    size_t TextureStreamer::chainBytes(const StreamedTexture& texture, uint32_t baseMip) const {
+        size_t bytes = 0;
+        for (uint32_t level = baseMip; level < texture.mipCount; level++) {
+            bytes += static_cast<size_t>(std::max(texture.width >> level, 1u)) *
+                     std::max(texture.height >> level, 1u) * 4;
+        }
+        return bytes;
+    }
+
+    void TextureStreamer::workerLoop() {
+        while (true) {
+            LoadRequest request;
+            {
+                std::unique_lock<std::mutex> lock(m_RequestMutex);
+                m_RequestCondition.wait(lock, [this] { return !m_Running || !m_Requests.empty(); });
+                if (!m_Running) {
+                    return;
+                }
+                request = m_Requests.front();
+                m_Requests.pop_front();
+            }
+
+            // Failures are reported from processUploads, which also rolls the committed bytes back
+            LoadResult result{request.texture, request.baseMip, {}};
+            if (!readMipChain(*request.texture, request.baseMip, result.pixels)) {
+                result.pixels.clear();
+            }
+
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            m_Results.push_back(std::move(result));
+        }
+    }
+
+    bool TextureStreamer::openMipChainFile(const StreamedTexture& texture, std::ifstream& file) const {
+        file.open(texture.chainPath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        auto fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        // A file built from an older version of the texture, or cut short, is built again
+        MipChainHeader header = {};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return file && header.magic == MIP_CHAIN_MAGIC && header.version == MIP_CHAIN_VERSION &&
+               header.width == texture.width && header.height == texture.height &&
+               header.mipCount == texture.mipCount && fileSize == sizeof(header) + chainBytes(texture, 0);
+    }
+
+    bool TextureStreamer::readMipChain(const StreamedTexture& texture, uint32_t baseMip,
+                                       std::vector<unsigned char>& pixels) const {
+        // The file holds mip 0 first, the chain from baseMip on is its last chainBytes(baseMip) bytes
+        size_t offset = chainBytes(texture, 0) - chainBytes(texture, baseMip);
+        pixels.resize(chainBytes(texture, baseMip));
+
+        if (!texture.chainPixels.empty()) {
+            std::copy(texture.chainPixels.begin() + offset, texture.chainPixels.end(), pixels.begin());
+            return true;
+        }
+
+        std::ifstream file;
+        if (!openMipChainFile(texture, file)) {
+            return false;
+        }
+        file.seekg(sizeof(MipChainHeader) + offset);
+        file.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+        return static_cast<bool>(file);
+    }
+
+    bool TextureStreamer::decodeMipChain(const std::string& filePath, std::vector<unsigned char>& pixels) {
+        int texWidth, texHeight, texChannels;
+        stbi_uc* decoded = stbi_load(filePath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+        if (!decoded) {
+            return false;
+        }
+
+        std::vector<unsigned char> level(decoded, decoded + static_cast<size_t>(texWidth) * texHeight * 4);
+        stbi_image_free(decoded);
+
+        uint32_t levelWidth = static_cast<uint32_t>(texWidth);
+        uint32_t levelHeight = static_cast<uint32_t>(texHeight);
+        std::vector<unsigned char> next;
+
+        // Pack mip 0 followed by every smaller mip down to 1x1
+        pixels.clear();
+        pixels.insert(pixels.end(), level.begin(), level.end());
+        while (levelWidth > 1 || levelHeight > 1) {
+            downsampleRGBA8(level, levelWidth, levelHeight, next);
+            level.swap(next);
+            levelWidth = std::max(levelWidth / 2, 1u);
+            levelHeight = std::max(levelHeight / 2, 1u);
+            pixels.insert(pixels.end(), level.begin(), level.end());
+        }
+        return true;
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef YARE_TEXTURE_STREAMER_H
+#define YARE_TEXTURE_STREAMER_H
+
+#include "Graphics/Renderers/Renderer.h"
+#include "Graphics/Components/Material.h"
+#include "Graphics/Camera/Camera.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    struct TextureStreamerInfo {
+        // Upper bound of texture memory the streamer is allowed to keep resident
+        size_t   budgetBytes = 256 * 1024 * 1024;
+        // Mips at or below this size are loaded up front and are never evicted
+        uint32_t residentTailSize = 64;
+        // A texture has to go unseen for this many frames before it is evicted
+        uint32_t evictionDelay = 120;
+    };
+
+    // Keeps the low mips of every registered 2D material resident and streams the
+    // higher mips in on a worker thread, based on how large the material is on screen.
+    // Every texture is decoded once, into a mip chain file next to it, and loads only read the mips they need.
+    class TextureStreamer {
+    public:
+        TextureStreamer(const TextureStreamerInfo& info);
+        ~TextureStreamer();
+
+        // Loads the resident mip tail synchronously and starts tracking the material.
+        // Builds the mip chain file of the texture first if there is none, or it was built from another size.
+        void registerMaterial(const std::shared_ptr<Material>& material);
+
+        // Estimates the required mip for every submitted entity and queues loads or evictions
+        void updateResidency(const CommandQueue& commandQueue, const Camera& camera, uint32_t screenHeight);
+
+        // Swaps finished loads into their materials, returns true if any texture image changed.
+        // Must be called while the GPU is not using the material textures.
+        bool processUploads();
+
+        // A lower budget evicts textures that have gone unseen on the next updateResidency
+        void setBudgetBytes(size_t budgetBytes) { m_Info.budgetBytes = budgetBytes; }
+
+        size_t getResidentBytes()  const { return m_ResidentBytes; }
+        size_t getBudgetBytes()    const { return m_Info.budgetBytes; }
+
+    private:
+        struct StreamedTexture {
+            Material* material = nullptr;
+            std::string filePath;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t mipCount = 1;
+            uint32_t tailMip = 0;
+            // Base mip of the image currently bound to the material
+            uint32_t residentMip = 0;
+            // Base mip we are loading towards, equal to residentMip when nothing is in flight
+            uint32_t targetMip = 0;
+            uint32_t desiredMip = 0;
+            uint64_t lastUsedFrame = 0;
+            // Tail mips are kept on the CPU so that an eviction never has to touch the disk
+            std::vector<unsigned char> tailPixels;
+            // Holds every mip instead when the mip chain file could not be written
+            std::vector<unsigned char> chainPixels;
+            std::string chainPath;
+        };
+
+        struct LoadRequest {
+            StreamedTexture* texture;
+            uint32_t baseMip;
+        };
+
+        struct LoadResult {
+            StreamedTexture* texture;
+            uint32_t baseMip;
+            std::vector<unsigned char> pixels;
+        };
+
+        void workerLoop();
+        void queueLoad(StreamedTexture& texture, uint32_t baseMip);
+        void evict(StreamedTexture& texture);
+        // The requester, if any, is never evicted to make room for itself
+        bool makeRoom(size_t bytesNeeded, const StreamedTexture* requester);
+        uint32_t estimateMip(const StreamedTexture& texture, const Entity& entity,
+                             const Camera& camera, uint32_t screenHeight) const;
+        size_t chainBytes(const StreamedTexture& texture, uint32_t baseMip) const;
+
+        // Reads mip baseMip and every smaller one, packed the way createTexture2DMipChain expects them
+        bool readMipChain(const StreamedTexture& texture, uint32_t baseMip, std::vector<unsigned char>& pixels) const;
+        bool openMipChainFile(const StreamedTexture& texture, std::ifstream& file) const;
+
+        static bool decodeMipChain(const std::string& filePath, std::vector<unsigned char>& pixels);
+
+    private:
+        TextureStreamerInfo m_Info;
+
+        std::unordered_map<const Material*, std::unique_ptr<StreamedTexture>> m_Textures;
+        uint64_t m_FrameIndex = 0;
+        // Bytes of every texture at its target mip, so in flight loads count against the budget
+        size_t m_CommittedBytes = 0;
+        size_t m_ResidentBytes = 0;
+
+        std::thread                     m_Worker;
+        std::atomic<bool>               m_Running{true};
+        std::mutex                      m_RequestMutex;
+        std::condition_variable         m_RequestCondition;
+        std::deque<LoadRequest>         m_Requests;
+        std::mutex                      m_ResultMutex;
+        std::vector<LoadResult>         m_Results;
+    };
+}
+
+#endif // YARE_TEXTURE_STREAMER_H
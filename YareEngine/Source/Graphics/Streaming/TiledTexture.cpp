@@ -0,0 +1,135 @@
+#include "Graphics/Streaming/TiledTexture.h"
+#include "Graphics/Streaming/MipChain.h"
+#include "Utilities/Logger.h"
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+
+namespace Yare::Graphics {
+
+    namespace {
+        const uint32_t TILED_TEXTURE_MAGIC = 0x58545659; // "YVTX"
+        const uint32_t TILED_TEXTURE_VERSION = 1;
+
+        bool isPowerOfTwo(uint32_t value) {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+    }
+
+    bool TiledTexture::convert(const std::string& sourcePath, const std::string& destPath,
+                               uint32_t tileSize, uint32_t border) {
+        int texWidth, texHeight, texChannels;
+        stbi_uc* decoded = stbi_load(sourcePath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+        if (!decoded) {
+            YZ_ERROR("TiledTexture failed to load source image: " + sourcePath);
+            return false;
+        }
+
+        uint32_t size = static_cast<uint32_t>(texWidth);
+        if (texWidth != texHeight || !isPowerOfTwo(size) || !isPowerOfTwo(tileSize) || size < tileSize) {
+            YZ_ERROR("TiledTexture sources must be square, a power of two and at least one tile: " + sourcePath);
+            stbi_image_free(decoded);
+            return false;
+        }
+
+        std::vector<unsigned char> level(decoded, decoded + static_cast<size_t>(size) * size * 4);
+        stbi_image_free(decoded);
+
+        std::ofstream file(destPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            YZ_ERROR("TiledTexture failed to open " + destPath + " for writing");
+            return false;
+        }
+
+        TiledTextureHeader header = {};
+        header.magic = TILED_TEXTURE_MAGIC;
+        header.version = TILED_TEXTURE_VERSION;
+        header.width = size;
+        header.height = size;
+        header.tileSize = tileSize;
+        header.border = border;
+        header.mipCount = 0;
+        for (uint32_t tiles = size / tileSize; tiles > 0; tiles /= 2) {
+            header.mipCount++;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        uint32_t paddedSize = tileSize + border * 2;
+        std::vector<unsigned char> tile(static_cast<size_t>(paddedSize) * paddedSize * 4);
+        std::vector<unsigned char> next;
+        uint32_t levelSize = size;
+
+        for (uint32_t mip = 0; mip < header.mipCount; mip++) {
+            uint32_t tiles = levelSize / tileSize;
+            for (uint32_t tileY = 0; tileY < tiles; tileY++) {
+                for (uint32_t tileX = 0; tileX < tiles; tileX++) {
+                    // Border texels come from the neighbouring tiles, clamped at the edge of the texture
+                    for (uint32_t y = 0; y < paddedSize; y++) {
+                        int64_t srcY = static_cast<int64_t>(tileY * tileSize + y) - border;
+                        srcY = std::clamp<int64_t>(srcY, 0, levelSize - 1);
+                        for (uint32_t x = 0; x < paddedSize; x++) {
+                            int64_t srcX = static_cast<int64_t>(tileX * tileSize + x) - border;
+                            srcX = std::clamp<int64_t>(srcX, 0, levelSize - 1);
+                            const unsigned char* src = &level[(srcY * levelSize + srcX) * 4];
+                            std::copy(src, src + 4, &tile[(y * paddedSize + x) * 4]);
+                        }
+                    }
+                    file.write(reinterpret_cast<const char*>(tile.data()), tile.size());
+                }
+            }
+
+            downsampleRGBA8(level, levelSize, levelSize, next);
+            level.swap(next);
+            levelSize /= 2;
+        }
+
+        return file.good();
+    }
+
+    bool TiledTexture::open(const std::string& filePath) {
+        m_File.open(filePath, std::ios::binary);
+        if (!m_File.is_open()) {
+            return false;
+        }
+
+        m_File.read(reinterpret_cast<char*>(&m_Header), sizeof(m_Header));
+        if (!m_File || m_Header.magic != TILED_TEXTURE_MAGIC || m_Header.version != TILED_TEXTURE_VERSION) {
+            m_File.close();
+            return false;
+        }
+
+        m_MipOffsets.resize(m_Header.mipCount);
+        uint64_t offset = sizeof(TiledTextureHeader);
+        for (uint32_t mip = 0; mip < m_Header.mipCount; mip++) {
+            m_MipOffsets[mip] = offset;
+            uint64_t tiles = getTilesPerSide(mip);
+            offset += tiles * tiles * getTileBytes();
+        }
+        return true;
+    }
+
+    bool TiledTexture::readTile(uint32_t mip, uint32_t x, uint32_t y, std::vector<unsigned char>& pixels) {
+        uint32_t tiles = getTilesPerSide(mip);
+        if (mip >= m_Header.mipCount || x >= tiles || y >= tiles) {
+            return false;
+        }
+
+        pixels.resize(getTileBytes());
+        m_File.seekg(m_MipOffsets[mip] + (static_cast<uint64_t>(y) * tiles + x) * getTileBytes());
+        m_File.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+        if (!m_File) {
+            m_File.clear();
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t TiledTexture::getTilesPerSide(uint32_t mip) const {
+        return std::max((m_Header.width / m_Header.tileSize) >> mip, 1u);
+    }
+
+    size_t TiledTexture::getTileBytes() const {
+        return static_cast<size_t>(getPaddedTileSize()) * getPaddedTileSize() * 4;
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef YARE_TILED_TEXTURE_H
+#define YARE_TILED_TEXTURE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // On disk the header is followed by every tile of mip 0 in row major order, then mip 1 and so on
+    // down to a single tile. Each tile is stored as RGBA8 with a border copied from its neighbours,
+    // so every tile has a fixed size and can be read with a single seek.
+    struct TiledTextureHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t tileSize;
+        uint32_t border;
+        uint32_t mipCount;
+    };
+
+    class TiledTexture {
+    public:
+        TiledTexture() = default;
+
+        // Splits a square, power of two image into the tiled format
+        static bool convert(const std::string& sourcePath, const std::string& destPath,
+                            uint32_t tileSize, uint32_t border);
+
+        bool open(const std::string& filePath);
+        bool readTile(uint32_t mip, uint32_t x, uint32_t y, std::vector<unsigned char>& pixels);
+
+        const TiledTextureHeader& getHeader()          const { return m_Header; }
+        uint32_t                  getTilesPerSide(uint32_t mip) const;
+        // Width of a stored tile in texels, including the border on both sides
+        uint32_t                  getPaddedTileSize()  const { return m_Header.tileSize + m_Header.border * 2; }
+        size_t                    getTileBytes()       const;
+
+    private:
+        TiledTextureHeader m_Header = {};
+        std::ifstream m_File;
+        std::vector<uint64_t> m_MipOffsets;
+    };
+}
+
+#endif // YARE_TILED_TEXTURE_H
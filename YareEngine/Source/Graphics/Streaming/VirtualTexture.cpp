@@ -0,0 +1,369 @@
+#include "Graphics/Streaming/VirtualTexture.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/Utilities.h"
+#include "Utilities/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace Yare::Graphics {
+
+    namespace {
+        uint32_t encodeEntry(uint32_t slotX, uint32_t slotY, uint32_t mip) {
+            return slotX | (slotY << 8) | (mip << 16) | (0xFFu << 24);
+        }
+    }
+
+    VirtualTexture::VirtualTexture(const VirtualTextureInfo& info)
+        : m_Info(info) {
+        if (m_Info.cacheTilesPerSide == 0 || m_Info.cacheTilesPerSide > 256) {
+            YZ_CRITICAL("VirtualTexture cache must be between 1 and 256 tiles per side, page table entries are 8 bit.");
+        }
+
+        if (!m_File.open(m_Info.filePath)) {
+            YZ_INFO("Building tiled texture " + m_Info.filePath + " from " + m_Info.sourcePath);
+            if (!TiledTexture::convert(m_Info.sourcePath, m_Info.filePath, m_Info.tileSize, m_Info.border) ||
+                !m_File.open(m_Info.filePath)) {
+                YZ_CRITICAL("VirtualTexture failed to open tiled texture: " + m_Info.filePath);
+            }
+        }
+
+        // The file decides the tile layout, it may have been built with other settings
+        const auto& header = m_File.getHeader();
+        m_Info.tileSize = header.tileSize;
+        m_Info.border = header.border;
+        m_PagesPerSide = m_File.getTilesPerSide(0);
+        m_MipCount = header.mipCount;
+
+        m_MipOffsets.resize(m_MipCount);
+        for (uint32_t mip = 0; mip < m_MipCount; mip++) {
+            m_MipOffsets[mip] = m_PageCount;
+            uint32_t pages = m_File.getTilesPerSide(mip);
+            m_PageCount += pages * pages;
+        }
+
+        m_Pages.resize(m_PageCount);
+        m_Slots.resize(m_Info.cacheTilesPerSide * m_Info.cacheTilesPerSide);
+        m_PageTableData.resize(m_PageCount);
+
+        uint32_t cacheSize = m_Info.cacheTilesPerSide * m_File.getPaddedTileSize();
+        m_TileCache = Image::createUpdatableTexture2D(cacheSize, cacheSize, VK_FORMAT_R8G8B8A8_SRGB,
+                                                      1, VK_FILTER_LINEAR);
+        m_PageTable = Image::createUpdatableTexture2D(m_PagesPerSide, m_PagesPerSide, VK_FORMAT_R8G8B8A8_UNORM,
+                                                      m_MipCount, VK_FILTER_NEAREST);
+
+        std::vector<uint32_t> cleared(m_PageCount, 0);
+        for (uint32_t i = 0; i < VulkanContext::getContext()->getMaxFramesInFlight(); i++) {
+            m_FeedbackBuffers.push_back(new Buffer(BufferUsage::STORAGE, getFeedbackSize(), nullptr));
+            m_FeedbackBuffers.back()->setData(getFeedbackSize(), cleared.data());
+        }
+
+        // The single page of the last mip is pinned to slot 0 so every lookup has something to fall back on
+        TileResult root{pageIndex(m_MipCount - 1, 0, 0), {}};
+        if (!m_File.readTile(m_MipCount - 1, 0, 0, root.pixels)) {
+            YZ_CRITICAL("VirtualTexture failed to read the root tile of " + m_Info.filePath);
+        }
+        m_Pages[root.page].pending = true;
+        m_Results.push_back(std::move(root));
+        processUploads();
+
+        m_Worker = std::thread(&VirtualTexture::workerLoop, this);
+    }
+
+    VirtualTexture::~VirtualTexture() {
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            m_Running = false;
+        }
+        m_RequestCondition.notify_all();
+        if (m_Worker.joinable()) {
+            m_Worker.join();
+        }
+
+        for (auto feedbackBuffer : m_FeedbackBuffers) {
+            delete feedbackBuffer;
+        }
+        delete m_PageTable;
+        delete m_TileCache;
+    }
+
+    void VirtualTexture::processFeedback(uint32_t frame) {
+        m_FrameIndex++;
+
+        std::vector<uint32_t> requested;
+        auto feedbackBuffer = m_FeedbackBuffers[frame];
+        if (feedbackBuffer->mapMemory(getFeedbackSize(), 0)) {
+            auto feedback = static_cast<uint32_t*>(feedbackBuffer->getMappedData());
+            for (uint32_t page = 0; page < m_PageCount; page++) {
+                if (feedback[page]) {
+                    requested.push_back(page);
+                }
+            }
+            std::memset(feedback, 0, getFeedbackSize());
+            feedbackBuffer->unmapMemory();
+        }
+
+        // Walk from every requested page towards the root, every missing page on the way is needed
+        // to refine the fallback, the first resident one is what is being sampled right now
+        std::vector<TileRequest> loads;
+        for (uint32_t page : requested) {
+            uint32_t mip, x, y;
+            pageCoords(page, mip, x, y);
+            for (; mip < m_MipCount; mip++, x /= 2, y /= 2) {
+                uint32_t current = pageIndex(mip, x, y);
+                if (m_Pages[current].slot >= 0) {
+                    touch(current);
+                    break;
+                }
+                if (!m_Pages[current].pending) {
+                    m_Pages[current].pending = true;
+                    loads.push_back({current, mip, x, y});
+                }
+            }
+        }
+
+        if (loads.empty()) {
+            return;
+        }
+
+        // Coarse pages first, they cover the most screen space per tile
+        std::sort(loads.begin(), loads.end(), [](const TileRequest& a, const TileRequest& b) {
+            return a.mip > b.mip;
+        });
+        // Don't queue more than a few frames of uploads, whatever is still visible is requested again
+        size_t maxLoads = m_Info.maxUploadsPerFrame * 4;
+        for (size_t i = maxLoads; i < loads.size(); i++) {
+            m_Pages[loads[i].page].pending = false;
+        }
+        if (loads.size() > maxLoads) {
+            loads.resize(maxLoads);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_RequestMutex);
+            m_Requests.insert(m_Requests.end(), loads.begin(), loads.end());
+        }
+        m_RequestCondition.notify_one();
+    }
+
+    bool VirtualTexture::processUploads() {
+        std::vector<TileResult> results;
+        {
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            while (!m_Results.empty() && results.size() < m_Info.maxUploadsPerFrame) {
+                results.push_back(std::move(m_Results.front()));
+                m_Results.pop_front();
+            }
+        }
+
+        size_t tileBytes = m_File.getTileBytes();
+        uint32_t paddedSize = m_File.getPaddedTileSize();
+        std::vector<unsigned char> staging;
+        staging.reserve(results.size() * tileBytes);
+        std::vector<VkBufferImageCopy> regions;
+
+        for (auto& result : results) {
+            Page& page = m_Pages[result.page];
+            page.pending = false;
+            if (result.pixels.empty()) {
+                YZ_WARN("VirtualTexture failed to read page {} of {}", result.page, m_Info.filePath);
+                continue;
+            }
+
+            int32_t slot = allocateSlot();
+            if (slot < 0) {
+                // Everything in the cache was sampled this frame, the page is requested again next frame
+                continue;
+            }
+            m_Slots[slot].page = static_cast<int32_t>(result.page);
+            m_Slots[slot].lastUsedFrame = m_FrameIndex;
+            page.slot = slot;
+            m_ResidentPages++;
+            m_ChangedPages.push_back(result.page);
+
+            VkBufferImageCopy region = {};
+            region.bufferOffset = staging.size();
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = { static_cast<int32_t>((slot % m_Info.cacheTilesPerSide) * paddedSize),
+                                   static_cast<int32_t>((slot / m_Info.cacheTilesPerSide) * paddedSize), 0 };
+            region.imageExtent = { paddedSize, paddedSize, 1 };
+            regions.push_back(region);
+
+            staging.insert(staging.end(), result.pixels.begin(), result.pixels.end());
+        }
+
+        if (regions.empty()) {
+            return false;
+        }
+
+        // Tiles and page table entries go in one submission, which the next frame is queued behind
+        VkCommandBuffer commandBuffer = VkUtil::beginSingleTimeCommands();
+        auto stagingBuffer = new Buffer(BufferUsage::TRANSFER, staging.size(), staging.data());
+        m_TileCache->updateRegions(commandBuffer, *stagingBuffer, regions);
+        updatePageTable(commandBuffer);
+        VkUtil::submitSingleTimeCommands(commandBuffer);
+        VulkanContext::getContext()->getDeletionQueue()->destroy(stagingBuffer);
+        return true;
+    }
+
+    void VirtualTexture::recordFeedbackBarrier(CommandBuffer& commandBuffer) const {
+        // The host reads the feedback once it has waited for the frame, this makes the shader writes visible to it
+        VkMemoryBarrier hostBarrier = {};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    VirtualTextureParams VirtualTexture::getShaderParams() const {
+        VirtualTextureParams params;
+        params.pageParams = glm::vec4(m_PagesPerSide, m_MipCount, 0.0f, 0.0f);
+        params.cacheParams = glm::vec4(m_Info.tileSize, m_Info.border, m_File.getPaddedTileSize(),
+                                       m_Info.cacheTilesPerSide * m_File.getPaddedTileSize());
+        return params;
+    }
+
+    uint32_t VirtualTexture::pageIndex(uint32_t mip, uint32_t x, uint32_t y) const {
+        return m_MipOffsets[mip] + y * m_File.getTilesPerSide(mip) + x;
+    }
+
+    void VirtualTexture::pageCoords(uint32_t page, uint32_t& mip, uint32_t& x, uint32_t& y) const {
+        mip = m_MipCount - 1;
+        while (mip > 0 && m_MipOffsets[mip] > page) {
+            mip--;
+        }
+        uint32_t pages = m_File.getTilesPerSide(mip);
+        x = (page - m_MipOffsets[mip]) % pages;
+        y = (page - m_MipOffsets[mip]) / pages;
+    }
+
+    int32_t VirtualTexture::allocateSlot() {
+        int32_t victim = -1;
+        for (int32_t slot = 0; slot < static_cast<int32_t>(m_Slots.size()); slot++) {
+            if (m_Slots[slot].page < 0) {
+                return slot;
+            }
+            // Slot 0 holds the root page, which is never evicted
+            if (slot == 0 || m_Slots[slot].lastUsedFrame >= m_FrameIndex) {
+                continue;
+            }
+            if (victim < 0 || m_Slots[slot].lastUsedFrame < m_Slots[victim].lastUsedFrame) {
+                victim = slot;
+            }
+        }
+
+        if (victim >= 0) {
+            m_ChangedPages.push_back(static_cast<uint32_t>(m_Slots[victim].page));
+            m_Pages[m_Slots[victim].page].slot = -1;
+            m_Slots[victim].page = -1;
+            m_ResidentPages--;
+        }
+        return victim;
+    }
+
+    void VirtualTexture::touch(uint32_t page) {
+        m_Slots[m_Pages[page].slot].lastUsedFrame = m_FrameIndex;
+    }
+
+    void VirtualTexture::updatePageTable(VkCommandBuffer commandBuffer) {
+        if (m_ChangedPages.empty()) {
+            return;
+        }
+
+        // Coarse to fine, so a page inheriting the entry of its parent sees the parent's new entry
+        std::sort(m_ChangedPages.begin(), m_ChangedPages.end(), std::greater<uint32_t>());
+        m_ChangedPages.erase(std::unique(m_ChangedPages.begin(), m_ChangedPages.end()), m_ChangedPages.end());
+        m_ChangedEntries.clear();
+        for (uint32_t page : m_ChangedPages) {
+            uint32_t mip, x, y;
+            pageCoords(page, mip, x, y);
+            updateEntry(mip, x, y);
+        }
+        m_ChangedPages.clear();
+
+        if (m_ChangedEntries.empty()) {
+            return;
+        }
+
+        // Runs of changed entries in a row of a mip are copied as one region
+        std::sort(m_ChangedEntries.begin(), m_ChangedEntries.end());
+        std::vector<uint32_t> staging;
+        staging.reserve(m_ChangedEntries.size());
+        std::vector<VkBufferImageCopy> regions;
+        for (size_t i = 0; i < m_ChangedEntries.size(); i++) {
+            uint32_t page = m_ChangedEntries[i];
+            uint32_t mip, x, y;
+            pageCoords(page, mip, x, y);
+            if (i == 0 || page != m_ChangedEntries[i - 1] + 1 || x == 0) {
+                VkBufferImageCopy region = {};
+                region.bufferOffset = staging.size() * sizeof(uint32_t);
+                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.imageSubresource.mipLevel = mip;
+                region.imageSubresource.baseArrayLayer = 0;
+                region.imageSubresource.layerCount = 1;
+                region.imageOffset = { static_cast<int32_t>(x), static_cast<int32_t>(y), 0 };
+                region.imageExtent = { 0, 1, 1 };
+                regions.push_back(region);
+            }
+            regions.back().imageExtent.width++;
+            staging.push_back(m_PageTableData[page]);
+        }
+
+        auto stagingBuffer = new Buffer(BufferUsage::TRANSFER, staging.size() * sizeof(uint32_t), staging.data());
+        m_PageTable->updateRegions(commandBuffer, *stagingBuffer, regions);
+        VulkanContext::getContext()->getDeletionQueue()->destroy(stagingBuffer);
+    }
+
+    void VirtualTexture::updateEntry(uint32_t mip, uint32_t x, uint32_t y) {
+        uint32_t page = pageIndex(mip, x, y);
+        int32_t slot = m_Pages[page].slot;
+        uint32_t entry = slot >= 0 ? encodeEntry(slot % m_Info.cacheTilesPerSide, slot / m_Info.cacheTilesPerSide, mip)
+                                   : m_PageTableData[pageIndex(mip + 1, x / 2, y / 2)];
+        if (entry == m_PageTableData[page]) {
+            return;
+        }
+        m_PageTableData[page] = entry;
+        m_ChangedEntries.push_back(page);
+
+        // Children without a tile of their own inherit this entry, the others keep theirs
+        if (mip == 0) {
+            return;
+        }
+        uint32_t childPages = m_File.getTilesPerSide(mip - 1);
+        for (uint32_t childY = y * 2; childY < std::min(y * 2 + 2, childPages); childY++) {
+            for (uint32_t childX = x * 2; childX < std::min(x * 2 + 2, childPages); childX++) {
+                if (m_Pages[pageIndex(mip - 1, childX, childY)].slot < 0) {
+                    updateEntry(mip - 1, childX, childY);
+                }
+            }
+        }
+    }
+
+    void VirtualTexture::workerLoop() {
+        while (true) {
+            TileRequest request;
+            {
+                std::unique_lock<std::mutex> lock(m_RequestMutex);
+                m_RequestCondition.wait(lock, [this] { return !m_Running || !m_Requests.empty(); });
+                if (!m_Running) {
+                    return;
+                }
+                request = m_Requests.front();
+                m_Requests.pop_front();
+            }
+
+            // A failed read is queued like any other, processUploads reports it with its page
+            TileResult result{request.page, {}};
+            if (!m_File.readTile(request.mip, request.x, request.y, result.pixels)) {
+                result.pixels.clear();
+            }
+
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            m_Results.push_back(std::move(result));
+        }
+    }
+}
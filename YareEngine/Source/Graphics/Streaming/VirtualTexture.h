@@ -0,0 +1,135 @@
+#ifndef YARE_VIRTUAL_TEXTURE_H
+#define YARE_VIRTUAL_TEXTURE_H
+
+#include "Graphics/Streaming/TiledTexture.h"
+#include "Graphics/Vulkan/Image.h"
+#include "Graphics/Vulkan/Buffer.h"
+#include "Graphics/Vulkan/CommandBuffer.h"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    struct VirtualTextureInfo {
+        // Tiled texture the pages are streamed from
+        std::string filePath;
+        // Image the tiled texture is built from when filePath does not exist yet
+        std::string sourcePath;
+        uint32_t tileSize = 128;
+        uint32_t border = 4;
+        // The physical cache holds cacheTilesPerSide * cacheTilesPerSide tiles
+        uint32_t cacheTilesPerSide = 16;
+        // Caps the number of tiles copied into the cache each frame
+        uint32_t maxUploadsPerFrame = 8;
+    };
+
+    // Pushed to the shaders that sample the virtual texture
+    struct VirtualTextureParams {
+        // x = pages per side at mip 0, y = mip count
+        glm::vec4 pageParams;
+        // x = tile size, y = border, z = padded tile size, w = cache size in texels
+        glm::vec4 cacheParams;
+    };
+
+    // A texture far larger than video memory, split into pages that are streamed into a fixed size
+    // tile cache. Shaders write the pages they sample into a feedback buffer, the page table maps every
+    // page onto the closest resident tile in the cache.
+    class VirtualTexture {
+    public:
+        VirtualTexture(const VirtualTextureInfo& info);
+        ~VirtualTexture();
+
+        // Reads the pages requested by the last frame rendered with this frame index and queues loads for
+        // the ones that are missing. Must be called after the frame that wrote the feedback has completed.
+        void processFeedback(uint32_t frame);
+
+        // Copies finished tiles into the cache and the page table entries they changed, returns true if any
+        // tile was uploaded. The copies are queued behind the frames already submitted and ahead of the next
+        // one, nothing waits for them.
+        bool processUploads();
+
+        // Records what the CPU needs to read the feedback a frame wrote, outside of the render pass
+        void recordFeedbackBarrier(CommandBuffer& commandBuffer) const;
+
+        const Image*         getPageTable()          const { return m_PageTable; }
+        const Image*         getTileCache()          const { return m_TileCache; }
+        // Every frame in flight writes its own feedback
+        const Buffer*        getFeedbackBuffer(uint32_t frame) const { return m_FeedbackBuffers[frame]; }
+        uint32_t             getFeedbackSize()       const { return m_PageCount * sizeof(uint32_t); }
+        uint32_t             getResidentPageCount()  const { return m_ResidentPages; }
+        VirtualTextureParams getShaderParams()       const;
+
+    private:
+        struct Page {
+            int32_t slot = -1;
+            bool pending = false;
+        };
+
+        struct Slot {
+            int32_t page = -1;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        struct TileRequest {
+            uint32_t page;
+            uint32_t mip;
+            uint32_t x;
+            uint32_t y;
+        };
+
+        struct TileResult {
+            uint32_t page;
+            std::vector<unsigned char> pixels;
+        };
+
+        uint32_t pageIndex(uint32_t mip, uint32_t x, uint32_t y) const;
+        void     pageCoords(uint32_t page, uint32_t& mip, uint32_t& x, uint32_t& y) const;
+        int32_t  allocateSlot();
+        void     touch(uint32_t page);
+        // Records the page table entries of every changed page and of the pages inheriting them
+        void     updatePageTable(VkCommandBuffer commandBuffer);
+        void     updateEntry(uint32_t mip, uint32_t x, uint32_t y);
+        void     workerLoop();
+
+    private:
+        VirtualTextureInfo m_Info;
+        TiledTexture m_File;
+
+        uint32_t m_PagesPerSide = 0;
+        uint32_t m_MipCount = 0;
+        uint32_t m_PageCount = 0;
+        std::vector<uint32_t> m_MipOffsets;
+
+        std::vector<Page> m_Pages;
+        std::vector<Slot> m_Slots;
+        // One RGBA8 entry per page, laid out like the feedback buffer
+        std::vector<uint32_t> m_PageTableData;
+        // Pages that gained or lost a tile since the page table was last updated
+        std::vector<uint32_t> m_ChangedPages;
+        std::vector<uint32_t> m_ChangedEntries;
+        uint32_t m_ResidentPages = 0;
+        uint64_t m_FrameIndex = 0;
+
+        Image*  m_PageTable = nullptr;
+        Image*  m_TileCache = nullptr;
+        std::vector<Buffer*> m_FeedbackBuffers;
+
+        std::thread                 m_Worker;
+        std::atomic<bool>           m_Running{true};
+        std::mutex                  m_RequestMutex;
+        std::condition_variable     m_RequestCondition;
+        std::deque<TileRequest>     m_Requests;
+        std::mutex                  m_ResultMutex;
+        std::deque<TileResult>      m_Results;
+    };
+}
+
+#endif // YARE_VIRTUAL_TEXTURE_H
@@ -1,5 +1,6 @@
 #include "Graphics/Vulkan/Buffer.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Utilities/Logger.h"
 
 namespace Yare::Graphics {
@@ -54,6 +55,16 @@ namespace Yare::Graphics {
             usageFlags = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
             propFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
             break;
+        case BufferUsage::STORAGE:
+            // Written by shaders and read back on the CPU
+            usageFlags = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            propFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            break;
+        case BufferUsage::READBACK:
+            // Copied into by the GPU, read on the CPU once the copy has completed
+            usageFlags = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            propFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            break;
         }
 
         createBuffer(usageFlags, propFlags);
@@ -68,6 +79,7 @@ namespace Yare::Graphics {
             auto p = static_cast<char*>(m_MappedData) + offset;
             memcpy((void*)p, data, size);
             unmapMemory();
+            RenderStatistics::instance()->add(RenderCounter::BytesUploaded, size);
         }
         else {
             YZ_ERROR("Mapping failed - Not copying data to buffer");
@@ -80,6 +92,7 @@ namespace Yare::Graphics {
             memcpy(p, data, size);
             flush(size, 0);
             unmapMemory();
+            RenderStatistics::instance()->add(RenderCounter::BytesUploaded, size);
         }
         else {
             YZ_ERROR("Mapping failed - Not copying data to buffer");
@@ -90,6 +103,7 @@ namespace Yare::Graphics {
         // Check that the index buffer bit was set inside the usageflags before binding
         if (m_Usage == BufferUsage::INDEX || m_Usage == BufferUsage::DYNAMIC_INDEX) {
             vkCmdBindIndexBuffer(commandBuffer->getCommandBuffer(), m_Buffer, 0, type);
+            RenderStatistics::instance()->add(RenderCounter::IndexBufferBinds);
         } else {
             YZ_WARN("Buffer was not of type Index. Did you intend to bind in this way?");
         }
@@ -101,6 +115,7 @@ namespace Yare::Graphics {
         if (m_Usage == BufferUsage::VERTEX || m_Usage == BufferUsage::DYNAMIC_VERTEX) {
             VkDeviceSize offset = 0;
             vkCmdBindVertexBuffers(commandBuffer->getCommandBuffer(), 0, 1, &m_Buffer, &offset);
+            RenderStatistics::instance()->add(RenderCounter::VertexBufferBinds);
         } else {
             YZ_WARN("Buffer was not of type Vertex. Did you intend to bind in this way?");
         }
@@ -112,6 +127,7 @@ namespace Yare::Graphics {
             YZ_ERROR("Failed to map buffer memory");
             return false;
         }
+        RenderStatistics::instance()->add(RenderCounter::BufferMaps);
         return true;
     }
 
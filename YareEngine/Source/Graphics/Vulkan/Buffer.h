@@ -14,7 +14,9 @@ namespace Yare::Graphics {
                             DYNAMIC_VERTEX,
                             INDEX,
                             DYNAMIC_INDEX,
-                            TRANSFER
+                            TRANSFER,
+                            STORAGE,
+                            READBACK
     };
 
     class Buffer {
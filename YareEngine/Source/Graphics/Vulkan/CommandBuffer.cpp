@@ -5,41 +5,34 @@
 
 namespace Yare::Graphics {
 
-        CommandBuffer::CommandBuffer() {
-            init();
+        CommandBuffer::CommandBuffer()
+            : m_CommandPool(VulkanContext::getContext()->getCommandPool().get()) {
+            init(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        }
+
+        CommandBuffer::CommandBuffer(const CommandPool* commandPool, VkCommandBufferLevel level)
+            : m_CommandPool(commandPool) {
+            init(level);
         }
 
         CommandBuffer::~CommandBuffer() {
-            if (m_Fence) {
-                 vkDestroyFence(Devices::instance()->getDevice(), m_Fence, nullptr);
-            }
             if (m_CommandBuffer) {
                 vkFreeCommandBuffers(Devices::instance()->getDevice(),
-                                     VulkanContext::getContext()->getCommandPool()->getPool(),
-                                     1, &m_CommandBuffer);
+                                     m_CommandPool->getPool(), 1, &m_CommandBuffer);
             }
         }
 
-        void CommandBuffer::init() {
+        void CommandBuffer::init(VkCommandBufferLevel level) {
             VkCommandBufferAllocateInfo allocInfo = {};
             allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            allocInfo.commandPool = VulkanContext::getContext()->getCommandPool()->getPool();
-            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = m_CommandPool->getPool();
+            allocInfo.level = level;
             allocInfo.commandBufferCount = 1;
 
             auto res = vkAllocateCommandBuffers(Devices::instance()->getDevice(), &allocInfo, &m_CommandBuffer);
             if (res != VK_SUCCESS) {
                 YZ_CRITICAL("Vulkan Failed to allocate command buffers.");
             }
-
-            VkFenceCreateInfo fenceInfo = {};
-            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-            fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-            res = vkCreateFence(Devices::instance()->getDevice(), &fenceInfo, nullptr, &m_Fence);
-            if (res != VK_SUCCESS) {
-                YZ_CRITICAL("Vulkan Failed to create a fence");
-            }
-            vkResetFences(Devices::instance()->getDevice(), 1, &m_Fence);
         }
 
     void CommandBuffer::beginRecording() {
@@ -7,18 +7,19 @@
 namespace Yare::Graphics {
     class CommandBuffer {
     public:
+        // Allocates from the context's command pool
         CommandBuffer();
+        CommandBuffer(const CommandPool* commandPool, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
         ~CommandBuffer();
 
         void beginRecording();
         void endRecording();
 
         const VkCommandBuffer& getCommandBuffer() const { return m_CommandBuffer; }
-        const VkFence& getFence() const { return m_Fence; }
     private:
-        void init();
+        void init(VkCommandBufferLevel level);
+        const CommandPool* m_CommandPool;
         VkCommandBuffer m_CommandBuffer;
-        VkFence m_Fence = VK_NULL_HANDLE;
     };
 }
 
@@ -4,8 +4,8 @@
 
 namespace Yare::Graphics {
 
-    CommandPool::CommandPool() {
-        init();
+    CommandPool::CommandPool(VkCommandPoolCreateFlags flags) {
+        init(flags);
     }
 
     CommandPool::~CommandPool() {
@@ -14,13 +14,13 @@ namespace Yare::Graphics {
         }
     }
 
-    void CommandPool::init() {
+    void CommandPool::init(VkCommandPoolCreateFlags flags) {
         Graphics::QueueFamilyIndices queueFamilyIndices = Devices::instance()->getQueueFamilyIndicies();
 
         VkCommandPoolCreateInfo poolInfo = {};
         poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily;
-        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT; // Optional
+        poolInfo.flags = flags;
 
         auto res = vkCreateCommandPool(Devices::instance()->getDevice(), &poolInfo, nullptr, &m_CommandPool);
         if (res != VK_SUCCESS) {
@@ -28,4 +28,11 @@ namespace Yare::Graphics {
         }
     }
 
+    void CommandPool::reset() {
+        auto res = vkResetCommandPool(Devices::instance()->getDevice(), m_CommandPool, 0);
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to reset a command pool.");
+        }
+    }
+
 }
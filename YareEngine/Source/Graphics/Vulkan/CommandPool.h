@@ -6,10 +6,13 @@
 namespace Yare::Graphics {
     class CommandPool {
     public:
-        CommandPool();
+        CommandPool(VkCommandPoolCreateFlags flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
         ~CommandPool();
 
-        void init();
+        void init(VkCommandPoolCreateFlags flags);
+        // Returns every command buffer allocated from the pool to the initial state at once,
+        // none of them may still be pending on the GPU
+        void reset();
         const VkCommandPool& getPool() const { return m_CommandPool; }
 
     private:
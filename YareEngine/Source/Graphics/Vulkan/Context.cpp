@@ -1,6 +1,7 @@
 #include "Graphics/Vulkan/Context.h"
 #include "Application/Application.h"
 #include "Utilities/Logger.h"
+#include "Utilities/Profiler.h"
 #include "Core/Glfw.h"
 
 namespace Yare::Graphics {
@@ -11,7 +12,7 @@ namespace Yare::Graphics {
                                                         VkDebugUtilsMessageTypeFlagsEXT messageType,
                                                         const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
                                                         void* pUserData) {
-        YZ_INFO("validation layer: " + std::string(pCallbackData->pMessage));
+        YZ_INFO("validation layer: {}", pCallbackData->pMessage);
         return VK_FALSE;
     }
 
@@ -39,17 +40,35 @@ namespace Yare::Graphics {
         }
     }
 
-    VulkanContext::VulkanContext(size_t width, size_t height) {
-        init(width, height);
+    VulkanContext::VulkanContext(size_t width, size_t height, bool headless, PresentMode presentMode,
+                                 uint32_t imageCount)
+        : m_Headless(headless) {
+        init(width, height, presentMode, imageCount);
         s_Context = this;
     }
 
     VulkanContext::~VulkanContext() {
+        // Everything still queued may reference the swapchain or the pools below
+        m_DeletionQueue.reset();
+        // Pipelines still compiling need the compiler, so they go before it
+        m_PipelineRegistry.reset();
+
         m_ImageAvailableSemaphores.clear();
         m_RenderFinishedSemaphores.clear();
+        m_FrameTimeline.reset();
+        m_UploadTimeline.reset();
 
-        m_Swapchain.reset();
+        m_GpuProfiler.reset();
+        m_RenderTarget.reset();
+        m_FrameCommandPools.reset();
         m_CommandPool.reset();
+        m_FrameDescriptorAllocators.clear();
+        m_DescriptorAllocator.reset();
+        m_DescriptorLayoutCache.reset();
+        m_SamplerCache.reset();
+        // Writes the cache back to disk, so it has to go before the device
+        m_PipelineCompiler.reset();
+        m_PipelineCache.reset();
 
         Devices::release();
 
@@ -61,7 +80,7 @@ namespace Yare::Graphics {
         }
     }
 
-    void VulkanContext::init(size_t width, size_t height) {
+    void VulkanContext::init(size_t width, size_t height, PresentMode presentMode, uint32_t imageCount) {
         // Create our link between our APP and the vulkan library
         createInstance();
         // Setup some validation layers such that if theres an issue with us
@@ -70,25 +89,66 @@ namespace Yare::Graphics {
 
         // Create our static device singleton
         m_Devices = Devices::instance();
-        m_Devices->init(m_Instance);
+        m_Devices->init(m_Instance, m_Headless);
+
+        // Only single time commands are allocated from the shared pool
+        m_CommandPool = std::make_shared<CommandPool>(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        // One pool per frame in flight and per thread that may record commands
+        m_FrameCommandPools = std::make_shared<FrameCommandPools>(MAX_FRAMES_IN_FLIGHT,
+                                                                  std::max(std::min(std::thread::hardware_concurrency(), 4u), 1u));
+        m_GpuProfiler = std::make_shared<GpuProfiler>(MAX_FRAMES_IN_FLIGHT);
+
+        // Layouts may bake samplers from this cache in, so it is created first and destroyed last
+        m_SamplerCache = std::make_shared<SamplerCache>();
+        m_DescriptorLayoutCache = std::make_shared<DescriptorLayoutCache>();
+        m_DescriptorAllocator = std::make_shared<DescriptorAllocator>();
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            m_FrameDescriptorAllocators.push_back(std::make_shared<DescriptorAllocator>());
+        }
 
-        m_CommandPool = std::make_shared<CommandPool>();
+        // Every pipeline is created through this cache, it is seeded from the previous run
+        m_PipelineCache = std::make_shared<PipelineCache>("pipeline.cache");
+        // Leave a core for the render thread, but keep one worker when the core count is unknown (0) or 1
+        m_PipelineCompiler = std::make_shared<PipelineCompiler>(std::max(std::min(std::thread::hardware_concurrency(), 5u), 2u) - 1);
+        m_PipelineRegistry = std::make_shared<PipelineRegistry>();
 
         // Create a swapchain, a swapchain is responsible for maintaining the images
-        // that will be presented to the user.
-        m_Swapchain = std::make_shared<Swapchain>(width, height);
+        // that will be presented to the user. Without a window the frames stay in our own images.
+        if (m_Headless) {
+            m_RenderTarget = std::make_shared<OffscreenTarget>(width, height, MAX_FRAMES_IN_FLIGHT);
+        } else {
+            m_RenderTarget = std::make_shared<Swapchain>(width, height, presentMode, imageCount);
+        }
 
         m_ImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
         m_RenderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+        m_FrameTimeline = std::make_shared<TimelineSemaphore>();
+        m_UploadTimeline = std::make_shared<TimelineSemaphore>();
+        m_DeletionQueue = std::make_shared<DeletionQueue>(m_FrameTimeline);
     }
 
     void VulkanContext::onResize(size_t width, size_t height) {
-        Devices::instance()->waitIdle();
-        m_Swapchain->onResize(width, height);
+        // The old swapchain and its views are retired through the deletion queue, no need to idle the device
+        m_RenderTarget->onResize(width, height);
     }
 
     bool VulkanContext::begin() {
-        auto result = m_Swapchain->acquireNextImage(m_ImageAvailableSemaphores[m_CurrentFrame].getSemaphore());
+        YZ_PROFILE_SCOPE("VulkanContext::begin");
+        // Up to MAX_FRAMES_IN_FLIGHT frames are queued on the GPU, only the one that last used this
+        // frame's command buffers, uniform buffers and descriptors has to finish before they are reused
+        {
+            YZ_PROFILE_SCOPE("Wait for GPU");
+            auto pendingValue = m_FrameTimeline->getPendingValue();
+            if (pendingValue >= static_cast<uint64_t>(MAX_FRAMES_IN_FLIGHT)) {
+                m_FrameTimeline->wait(pendingValue - (MAX_FRAMES_IN_FLIGHT - 1));
+            }
+        }
+        m_DeletionQueue->collect();
+        m_PipelineRegistry->collect();
+        m_FrameCommandPools->beginFrame(static_cast<uint32_t>(m_CurrentFrame));
+        m_FrameDescriptorAllocators[m_CurrentFrame]->reset();
+
+        auto result = m_RenderTarget->acquireNextImage(m_ImageAvailableSemaphores[m_CurrentFrame].getSemaphore());
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
             return false;
@@ -100,10 +160,11 @@ namespace Yare::Graphics {
     }
 
     bool VulkanContext::present(CommandBuffer* cmdBuffer) {
+        YZ_PROFILE_SCOPE("VulkanContext::present");
 
-        submitGfxQueue(cmdBuffer, true);
+        submitGfxQueue(cmdBuffer);
 
-        VkResult result = m_Swapchain->present(m_RenderFinishedSemaphores[m_CurrentFrame].getSemaphore());
+        VkResult result = m_RenderTarget->present(m_RenderFinishedSemaphores[m_CurrentFrame].getSemaphore());
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
             return false;
@@ -116,9 +177,27 @@ namespace Yare::Graphics {
         return true;
     }
 
-    void VulkanContext::submitGfxQueue(CommandBuffer* cmdBuffer, bool waitFence) {
+    void VulkanContext::submitGfxQueue(CommandBuffer* cmdBuffer) {
         auto currentWaitSemaphore = m_ImageAvailableSemaphores[m_CurrentFrame].getSemaphore();
-        auto currentSignalSemaphore = m_RenderFinishedSemaphores[m_CurrentFrame].getSemaphore();
+        // The swapchain only understands binary semaphores, the timeline is signaled alongside
+        VkSemaphore signalSemaphores[] = { m_RenderFinishedSemaphores[m_CurrentFrame].getSemaphore(),
+                                           m_FrameTimeline->getSemaphore() };
+
+        // Values for binary semaphores are ignored
+        uint64_t waitValue = 0;
+        uint64_t signalValues[] = { 0, m_FrameTimeline->nextValue() };
+
+        // Offscreen images are neither acquired nor presented, only the timeline is signaled
+        bool presentable = m_RenderTarget->isPresentable();
+        uint32_t waitCount = presentable ? 1 : 0;
+        uint32_t signalOffset = presentable ? 0 : 1;
+
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.waitSemaphoreValueCount = waitCount;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+        timelineInfo.signalSemaphoreValueCount = 2 - signalOffset;
+        timelineInfo.pSignalSemaphoreValues = signalValues + signalOffset;
 
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -127,20 +206,13 @@ namespace Yare::Graphics {
         VkPipelineStageFlags flags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         submitInfo.pWaitDstStageMask = &flags;
         submitInfo.pWaitSemaphores = &currentWaitSemaphore;
-        submitInfo.waitSemaphoreCount = (uint32_t)(currentWaitSemaphore ? 1 : 0);
-        submitInfo.pSignalSemaphores = &currentSignalSemaphore;
-        submitInfo.signalSemaphoreCount =  (uint32_t)(currentSignalSemaphore ? 1 : 0);
-        submitInfo.pNext = VK_NULL_HANDLE;
+        submitInfo.waitSemaphoreCount = waitCount;
+        submitInfo.pSignalSemaphores = signalSemaphores + signalOffset;
+        submitInfo.signalSemaphoreCount = 2 - signalOffset;
+        submitInfo.pNext = &timelineInfo;
 
-        if (!waitFence) {
-            vkQueueSubmit(m_Devices->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-            vkQueueWaitIdle(m_Devices->getGraphicsQueue());
-        }
-        else {
-            auto fence = cmdBuffer->getFence();
-            vkQueueSubmit(m_Devices->getGraphicsQueue(), 1, &submitInfo, fence);
-            vkWaitForFences(m_Devices->getDevice(), 1, &fence, VK_TRUE, UINT64_MAX);
-            vkResetFences(m_Devices->getDevice(), 1, &fence);
+        if (vkQueueSubmit(m_Devices->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to submit a frame.");
         }
     }
 
@@ -207,11 +279,15 @@ namespace Yare::Graphics {
     }
 
     std::vector<const char*> VulkanContext::getRequiredExtensions() {
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions;
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        std::vector<const char*> extensions;
+
+        // Surface extensions, GLFW is never initialized without a window
+        if (!m_Headless) {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions;
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         if (enableValidationLayers) {
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
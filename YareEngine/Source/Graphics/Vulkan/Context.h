@@ -5,34 +5,69 @@
 #include "Graphics/Vulkan/CommandPool.h"
 #include "Graphics/Vulkan/Devices.h"
 #include "Graphics/Vulkan/Swapchain.h"
+#include "Graphics/Vulkan/OffscreenTarget.h"
 #include "Graphics/Vulkan/CommandBuffer.h"
+#include "Graphics/Vulkan/FrameCommandPools.h"
 #include "Graphics/Vulkan/Semaphore.h"
+#include "Graphics/Vulkan/TimelineSemaphore.h"
+#include "Graphics/Vulkan/DeletionQueue.h"
+#include "Graphics/Vulkan/DescriptorLayoutCache.h"
+#include "Graphics/Vulkan/DescriptorAllocator.h"
+#include "Graphics/Vulkan/SamplerCache.h"
+#include "Graphics/Vulkan/PipelineCache.h"
+#include "Graphics/Vulkan/PipelineCompiler.h"
+#include "Graphics/Vulkan/PipelineRegistry.h"
+#include "Graphics/Vulkan/GpuProfiler.h"
 
 namespace Yare::Graphics {
 
     class VulkanContext {
     public:
-        VulkanContext(size_t width, size_t height);
+        // A headless context renders into offscreen images and needs neither a window nor a surface,
+        // the present mode and image count only apply to a swapchain
+        VulkanContext(size_t width, size_t height, bool headless = false,
+                      PresentMode presentMode = PresentMode::Throughput, uint32_t imageCount = 3);
         ~VulkanContext();
 
         void onResize(size_t width, size_t height);
         bool begin();
         bool present(CommandBuffer* cmdBuffer);
 
-        const std::shared_ptr<Swapchain>&   getSwapchain()    const { return m_Swapchain; }
+        // The swapchain, or the offscreen images of a headless context
+        const std::shared_ptr<RenderTarget>& getRenderTarget() const { return m_RenderTarget; }
+        bool                                isHeadless()      const { return m_Headless; }
         const std::shared_ptr<CommandPool>& getCommandPool()  const { return m_CommandPool; }
+        // Command buffers recorded each frame come from here, the current frame's pools are reset by begin()
+        const std::shared_ptr<FrameCommandPools>& getFrameCommandPools() const { return m_FrameCommandPools; }
+        const std::shared_ptr<SamplerCache>& getSamplerCache() const { return m_SamplerCache; }
+        const std::shared_ptr<DescriptorLayoutCache>& getDescriptorLayoutCache() const { return m_DescriptorLayoutCache; }
+        // Persistent sets live as long as the allocator, transient ones until their frame comes round again
+        const std::shared_ptr<DescriptorAllocator>& getDescriptorAllocator() const { return m_DescriptorAllocator; }
+        const std::shared_ptr<DescriptorAllocator>& getFrameDescriptorAllocator() const { return m_FrameDescriptorAllocators[m_CurrentFrame]; }
+        const std::shared_ptr<PipelineCache>& getPipelineCache() const { return m_PipelineCache; }
+        const std::shared_ptr<PipelineCompiler>& getPipelineCompiler() const { return m_PipelineCompiler; }
+        // Renderers get their pipelines from here so that equal pipeline state is only compiled once
+        const std::shared_ptr<PipelineRegistry>& getPipelineRegistry() const { return m_PipelineRegistry; }
+        // Signaled with an increasing value by every frame and every upload respectively
+        const std::shared_ptr<TimelineSemaphore>& getFrameTimeline()    const { return m_FrameTimeline; }
+        const std::shared_ptr<TimelineSemaphore>& getUploadTimeline()   const { return m_UploadTimeline; }
+        const std::shared_ptr<DeletionQueue>&     getDeletionQueue()    const { return m_DeletionQueue; }
+        const std::shared_ptr<GpuProfiler>&       getGpuProfiler()      const { return m_GpuProfiler; }
+        uint32_t                            getMaxFramesInFlight() const { return MAX_FRAMES_IN_FLIGHT; }
+        // Index of the frame in flight being recorded
+        uint32_t                            getCurrentFrame()      const { return static_cast<uint32_t>(m_CurrentFrame); }
         const VkInstance&                   getInstance()     const { return m_Instance; }
         const static VulkanContext*         getContext()            { return s_Context; }
 
     private:
-        void init(size_t width, size_t height);
+        void init(size_t width, size_t height, PresentMode presentMode, uint32_t imageCount);
         void createInstance();
         void setupDebugMessenger();
         void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
         std::vector<const char*> getRequiredExtensions();
         bool checkValidationLayerSupport();
 
-        void submitGfxQueue(CommandBuffer* cmdBuffer, bool waitFence);
+        void submitGfxQueue(CommandBuffer* cmdBuffer);
 
     private:
         VkInstance                        m_Instance = VK_NULL_HANDLE;
@@ -41,10 +76,23 @@ namespace Yare::Graphics {
         static VulkanContext*             s_Context;
         Devices*                          m_Devices;
         std::shared_ptr<CommandPool>      m_CommandPool;
-        std::shared_ptr<Swapchain>        m_Swapchain;
+        std::shared_ptr<FrameCommandPools> m_FrameCommandPools;
+        std::shared_ptr<SamplerCache>     m_SamplerCache;
+        std::shared_ptr<DescriptorLayoutCache> m_DescriptorLayoutCache;
+        std::shared_ptr<DescriptorAllocator> m_DescriptorAllocator;
+        std::vector<std::shared_ptr<DescriptorAllocator>> m_FrameDescriptorAllocators;
+        std::shared_ptr<PipelineCache>    m_PipelineCache;
+        std::shared_ptr<PipelineCompiler> m_PipelineCompiler;
+        std::shared_ptr<PipelineRegistry> m_PipelineRegistry;
+        std::shared_ptr<RenderTarget>     m_RenderTarget;
+        bool                              m_Headless = false;
 
         std::vector<Semaphore>            m_ImageAvailableSemaphores;
         std::vector<Semaphore>            m_RenderFinishedSemaphores;
+        std::shared_ptr<TimelineSemaphore> m_FrameTimeline;
+        std::shared_ptr<TimelineSemaphore> m_UploadTimeline;
+        std::shared_ptr<DeletionQueue>    m_DeletionQueue;
+        std::shared_ptr<GpuProfiler>      m_GpuProfiler;
         size_t                            m_CurrentFrame = 0;
 
         const std::vector<const char*> validationLayers = { "VK_LAYER_KHRONOS_validation" };
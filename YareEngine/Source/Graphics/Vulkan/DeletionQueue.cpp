@@ -0,0 +1,39 @@
+#include "Graphics/Vulkan/DeletionQueue.h"
+
+namespace Yare::Graphics {
+
+    DeletionQueue::DeletionQueue(const std::shared_ptr<TimelineSemaphore>& frameTimeline)
+        : m_FrameTimeline(frameTimeline) {
+    }
+
+    DeletionQueue::~DeletionQueue() {
+        flush();
+    }
+
+    void DeletionQueue::push(std::function<void()> deleter) {
+        // The frame being recorded signals the next value when it is submitted
+        m_Entries.push_back({m_FrameTimeline->getPendingValue() + 1, std::move(deleter)});
+    }
+
+    void DeletionQueue::collect() {
+        if (m_Entries.empty()) {
+            return;
+        }
+
+        // Entries are pushed in frame order, so stop at the first one still in flight
+        uint64_t completedValue = m_FrameTimeline->getCompletedValue();
+        while (!m_Entries.empty() && m_Entries.front().frameValue <= completedValue) {
+            auto deleter = std::move(m_Entries.front().deleter);
+            m_Entries.pop_front();
+            deleter();
+        }
+    }
+
+    void DeletionQueue::flush() {
+        while (!m_Entries.empty()) {
+            auto deleter = std::move(m_Entries.front().deleter);
+            m_Entries.pop_front();
+            deleter();
+        }
+    }
+}
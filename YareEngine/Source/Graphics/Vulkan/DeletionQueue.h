@@ -0,0 +1,46 @@
+#ifndef YARE_DELETION_QUEUE_H
+#define YARE_DELETION_QUEUE_H
+
+#include "Graphics/Vulkan/TimelineSemaphore.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace Yare::Graphics {
+
+    // Defers the destruction of Vulkan objects until every frame that could have used them
+    // has completed on the GPU, so they can be replaced at any time without waiting for the device.
+    class DeletionQueue {
+    public:
+        DeletionQueue(const std::shared_ptr<TimelineSemaphore>& frameTimeline);
+        ~DeletionQueue();
+
+        // Runs deleter once the frame currently being recorded, and every frame before it, has completed
+        void push(std::function<void()> deleter);
+
+        // Deletes object once it can no longer be in use, a null object is ignored
+        template<typename T>
+        void destroy(T* object) {
+            if (object) {
+                push([object] { delete object; });
+            }
+        }
+
+        // Runs the deleters of every completed frame, called once per frame
+        void collect();
+        // Runs every deleter, the device must be idle
+        void flush();
+
+    private:
+        struct Entry {
+            uint64_t frameValue;
+            std::function<void()> deleter;
+        };
+
+        std::shared_ptr<TimelineSemaphore> m_FrameTimeline;
+        std::deque<Entry>                  m_Entries;
+    };
+}
+
+#endif // YARE_DELETION_QUEUE_H
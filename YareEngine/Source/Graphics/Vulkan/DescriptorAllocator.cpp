@@ -0,0 +1,97 @@
+#include "Graphics/Vulkan/DescriptorAllocator.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+#include <utility>
+
+namespace Yare::Graphics {
+
+    // Descriptors of each type reserved per set in a pool. Texture arrays are the largest consumer,
+    // a single set may hold MAX_NUM_TEXTURES samplers.
+    static const std::pair<VkDescriptorType, float> s_PoolRatios[] = {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         2.0f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1.0f },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 8.0f },
+    };
+
+    DescriptorAllocator::DescriptorAllocator(uint32_t setsPerPool)
+        : m_SetsPerPool(setsPerPool) {
+    }
+
+    DescriptorAllocator::~DescriptorAllocator() {
+        for (auto pool : m_UsedPools) {
+            vkDestroyDescriptorPool(Devices::instance()->getDevice(), pool, nullptr);
+        }
+        for (auto pool : m_FreePools) {
+            vkDestroyDescriptorPool(Devices::instance()->getDevice(), pool, nullptr);
+        }
+    }
+
+    VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout layout) {
+        if (!m_CurrentPool) {
+            m_CurrentPool = grabPool();
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_CurrentPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        auto res = vkAllocateDescriptorSets(Devices::instance()->getDevice(), &allocInfo, &descriptorSet);
+
+        // The current pool is full, move on to a fresh one
+        if (res == VK_ERROR_OUT_OF_POOL_MEMORY || res == VK_ERROR_FRAGMENTED_POOL) {
+            m_CurrentPool = grabPool();
+            allocInfo.descriptorPool = m_CurrentPool;
+            res = vkAllocateDescriptorSets(Devices::instance()->getDevice(), &allocInfo, &descriptorSet);
+        }
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan was unable to allocate descriptor sets.");
+        }
+        return descriptorSet;
+    }
+
+    void DescriptorAllocator::reset() {
+        for (auto pool : m_UsedPools) {
+            vkResetDescriptorPool(Devices::instance()->getDevice(), pool, 0);
+            m_FreePools.push_back(pool);
+        }
+        m_UsedPools.clear();
+        m_CurrentPool = VK_NULL_HANDLE;
+    }
+
+    VkDescriptorPool DescriptorAllocator::createPool() const {
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        for (const auto& [type, ratio] : s_PoolRatios) {
+            poolSizes.push_back({type, static_cast<uint32_t>(ratio * m_SetsPerPool)});
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = m_SetsPerPool;
+
+        VkDescriptorPool pool;
+        auto res = vkCreateDescriptorPool(Devices::instance()->getDevice(), &poolInfo, nullptr, &pool);
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan creation of descriptor pool failed.");
+        }
+        return pool;
+    }
+
+    VkDescriptorPool DescriptorAllocator::grabPool() {
+        VkDescriptorPool pool;
+        if (!m_FreePools.empty()) {
+            pool = m_FreePools.back();
+            m_FreePools.pop_back();
+        } else {
+            pool = createPool();
+        }
+        m_UsedPools.push_back(pool);
+        return pool;
+    }
+}
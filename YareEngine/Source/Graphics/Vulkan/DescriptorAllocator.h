@@ -0,0 +1,36 @@
+#ifndef YARE_DESCRIPTOR_ALLOCATOR_H
+#define YARE_DESCRIPTOR_ALLOCATOR_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Allocates descriptor sets of any layout from a growing list of pools. A new pool is created
+    // whenever the current one runs out, reset() recycles every pool at once so transient sets can
+    // be allocated each frame without ever freeing them one by one.
+    class DescriptorAllocator {
+    public:
+        DescriptorAllocator(uint32_t setsPerPool = 64);
+        ~DescriptorAllocator();
+
+        VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+        // Every set allocated so far becomes invalid, none of them may still be in use by the GPU
+        void reset();
+
+        size_t getPoolCount() const { return m_UsedPools.size() + m_FreePools.size(); }
+
+    private:
+        VkDescriptorPool createPool() const;
+        VkDescriptorPool grabPool();
+
+    private:
+        uint32_t m_SetsPerPool;
+        VkDescriptorPool m_CurrentPool = VK_NULL_HANDLE;
+        std::vector<VkDescriptorPool> m_UsedPools;
+        std::vector<VkDescriptorPool> m_FreePools;
+    };
+}
+
+#endif // YARE_DESCRIPTOR_ALLOCATOR_H
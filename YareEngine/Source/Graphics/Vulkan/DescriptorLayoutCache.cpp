@@ -0,0 +1,84 @@
+#include "Graphics/Vulkan/DescriptorLayoutCache.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Yare::Graphics {
+
+    DescriptorLayoutCache::DescriptorLayoutCache() {
+    }
+
+    DescriptorLayoutCache::~DescriptorLayoutCache() {
+        for (auto& [key, layout] : m_Layouts) {
+            vkDestroyDescriptorSetLayout(Devices::instance()->getDevice(), layout, nullptr);
+        }
+    }
+
+    VkDescriptorSetLayout DescriptorLayoutCache::getLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+                                                           VkDescriptorSetLayoutCreateFlags flags) {
+        LayoutKey key{flags, bindings, {}};
+        std::sort(key.bindings.begin(), key.bindings.end(),
+                  [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) {
+                      return a.binding < b.binding;
+                  });
+        for (const auto& binding : key.bindings) {
+            if (binding.pImmutableSamplers) {
+                key.immutableSamplers.insert(key.immutableSamplers.end(), binding.pImmutableSamplers,
+                                             binding.pImmutableSamplers + binding.descriptorCount);
+            }
+        }
+
+        auto found = m_Layouts.find(key);
+        if (found != m_Layouts.end()) {
+            return found->second;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.flags = flags;
+        layoutInfo.bindingCount = static_cast<uint32_t>(key.bindings.size());
+        layoutInfo.pBindings = key.bindings.data();
+
+        VkDescriptorSetLayout layout;
+        auto res = vkCreateDescriptorSetLayout(Devices::instance()->getDevice(), &layoutInfo, nullptr, &layout);
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan was unable to create a descriptor set layout.");
+        }
+
+        m_Layouts.emplace(std::move(key), layout);
+        return layout;
+    }
+
+    bool DescriptorLayoutCache::LayoutKey::operator==(const LayoutKey& other) const {
+        if (flags != other.flags || bindings.size() != other.bindings.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < bindings.size(); i++) {
+            const auto& a = bindings[i];
+            const auto& b = other.bindings[i];
+            if (a.binding != b.binding || a.descriptorType != b.descriptorType ||
+                a.descriptorCount != b.descriptorCount || a.stageFlags != b.stageFlags ||
+                (a.pImmutableSamplers == nullptr) != (b.pImmutableSamplers == nullptr)) {
+                return false;
+            }
+        }
+        return immutableSamplers == other.immutableSamplers;
+    }
+
+    size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey& key) const {
+        size_t hash = std::hash<uint32_t>()(key.flags);
+        for (const auto& binding : key.bindings) {
+            // Pack the fields that make up the signature, then mix it in the way boost::hash_combine does
+            size_t packed = binding.binding | (static_cast<size_t>(binding.descriptorType) << 8) |
+                            (static_cast<size_t>(binding.stageFlags) << 16);
+            size_t value = std::hash<size_t>()(packed) ^ std::hash<uint32_t>()(binding.descriptorCount);
+            hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        for (auto sampler : key.immutableSamplers) {
+            hash ^= std::hash<VkSampler>()(sampler) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
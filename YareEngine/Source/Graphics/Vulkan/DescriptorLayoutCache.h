@@ -0,0 +1,45 @@
+#ifndef YARE_DESCRIPTOR_LAYOUT_CACHE_H
+#define YARE_DESCRIPTOR_LAYOUT_CACHE_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Hands out one descriptor set layout per distinct binding signature, so pipelines that declare
+    // the same bindings share a layout and layout compatible sets. Layouts live as long as the cache.
+    class DescriptorLayoutCache {
+    public:
+        DescriptorLayoutCache();
+        ~DescriptorLayoutCache();
+
+        // The order of the bindings does not matter. Immutable samplers are part of the signature,
+        // they should come from the sampler cache so that equal bindings also share their samplers.
+        VkDescriptorSetLayout getLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+                                        VkDescriptorSetLayoutCreateFlags flags = 0);
+
+        size_t getLayoutCount() const { return m_Layouts.size(); }
+
+    private:
+        struct LayoutKey {
+            VkDescriptorSetLayoutCreateFlags flags;
+            // Sorted by binding, pImmutableSamplers is only valid while the layout is created
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            // The immutable samplers of every binding that has them, in binding order
+            std::vector<VkSampler> immutableSamplers;
+
+            bool operator==(const LayoutKey& other) const;
+        };
+
+        struct LayoutKeyHash {
+            size_t operator()(const LayoutKey& key) const;
+        };
+
+    private:
+        std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> m_Layouts;
+    };
+}
+
+#endif // YARE_DESCRIPTOR_LAYOUT_CACHE_H
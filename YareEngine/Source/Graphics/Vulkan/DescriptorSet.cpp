@@ -1,82 +1,114 @@
 #include "Graphics/Vulkan/DescriptorSet.h"
+#include "Graphics/Vulkan/Context.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Utilities/Logger.h"
 
 namespace Yare::Graphics {
 
+    PFN_vkCmdPushDescriptorSetKHR DescriptorSet::s_CmdPushDescriptorSet = nullptr;
+
+    bool BufferInfo::operator==(const BufferInfo& other) const {
+        return buffer == other.buffer && type == other.type && imageView == other.imageView &&
+               imageSampler == other.imageSampler && offset == other.offset && size == other.size &&
+               binding == other.binding;
+    }
+
     DescriptorSet::DescriptorSet() {
     }
 
     DescriptorSet::~DescriptorSet() {
+        //The set is returned to its pool when the allocator is reset or destroyed
     }
 
-    void DescriptorSet::init(const DescriptorSetInfo& descriptorSetInfo) {
+    void DescriptorSet::loadFunctions(VkDevice device) {
+        s_CmdPushDescriptorSet = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(device,
+                                                                                    "vkCmdPushDescriptorSetKHR");
+    }
 
-        VkDescriptorSetAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool = descriptorSetInfo.pipeline->getDescriptorPool();
-        allocInfo.descriptorSetCount = static_cast<uint32_t>(descriptorSetInfo.descriptorSetCount);
-        allocInfo.pSetLayouts = &descriptorSetInfo.pipeline->getDescriptorSetLayout();
+    void DescriptorSet::init(const DescriptorSetInfo& descriptorSetInfo) {
+        m_Pipeline = descriptorSetInfo.pipeline;
+        m_Transient = descriptorSetInfo.transient;
 
-        //This wont need to be cleaned up because it is auto cleaned up when the pool is destroyed
-        auto res = vkAllocateDescriptorSets(Devices::instance()->getDevice(), &allocInfo, &m_DescriptorSets);
-        if (res != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan was unable to allocate descriptor sets.");
+        // Pushed descriptors are recorded straight into the command buffer, there is no set to allocate
+        if (m_Pipeline->usesPushDescriptors() || m_Transient) {
+            return;
         }
+        m_DescriptorSets = VulkanContext::getContext()->getDescriptorAllocator()->allocate(
+                m_Pipeline->getDescriptorSetLayout());
     }
 
-    void DescriptorSet::update(std::vector<BufferInfo>& newBufferInfo) {
+    void DescriptorSet::update(const std::vector<BufferInfo>& newBufferInfo) {
+        if (m_Transient && !m_Pipeline->usesPushDescriptors()) {
+            m_DescriptorSets = VulkanContext::getContext()->getFrameDescriptorAllocator()->allocate(
+                    m_Pipeline->getDescriptorSetLayout());
+        } else if (newBufferInfo == m_BufferInfos) {
+            return;
+        }
+        m_BufferInfos = newBufferInfo;
 
-        std::vector<VkWriteDescriptorSet> descriptorWrites = {};
+        buildWrites(newBufferInfo);
 
-        // Texture array reference; http://kylehalladay.com/blog/tutorial/vulkan/2018/01/28/Textue-Arrays-Vulkan.html
+        if (m_Pipeline->usesPushDescriptors()) {
+            return;
+        }
+        vkUpdateDescriptorSets(Devices::instance()->getDevice(),
+                               static_cast<uint32_t>(m_Writes.size()),
+                               m_Writes.data(), 0, nullptr);
+    }
 
-        // 32 is a magic number that we use for the max number of buffer infos
-        std::vector<VkDescriptorBufferInfo> bInfo;
-        std::vector<VkDescriptorImageInfo> imageInfo;
-        bInfo.resize(32);
-        imageInfo.resize(MAX_NUM_TEXTURES);
+    void DescriptorSet::bind(const CommandBuffer& commandBuffer, uint32_t dynamicOffsetCount,
+                             const uint32_t* dynamicOffsets) const {
+        if (m_Pipeline->usesPushDescriptors()) {
+            s_CmdPushDescriptorSet(commandBuffer.getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                   m_Pipeline->getPipelineLayout(), 0,
+                                   static_cast<uint32_t>(m_Writes.size()), m_Writes.data());
+        } else {
+            vkCmdBindDescriptorSets(commandBuffer.getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    m_Pipeline->getPipelineLayout(), 0, 1, &m_DescriptorSets,
+                                    dynamicOffsetCount, dynamicOffsets);
+        }
+        RenderStatistics::instance()->add(RenderCounter::DescriptorBinds);
+    }
 
-        uint32_t bufferIndex = 0;
-        uint32_t imageIndex = 0;
+    void DescriptorSet::buildWrites(const std::vector<BufferInfo>& newBufferInfo) {
+        // Texture array reference; http://kylehalladay.com/blog/tutorial/vulkan/2018/01/28/Textue-Arrays-Vulkan.html
+        m_Writes.clear();
+        m_BufferWrites.clear();
+        m_ImageWrites.clear();
+        // The writes point into these, they must not reallocate while being filled
+        m_BufferWrites.reserve(newBufferInfo.size());
+        m_ImageWrites.reserve(newBufferInfo.size());
 
         for (const auto& bufferInfo : newBufferInfo) {
-            if (bufferInfo.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
-                imageInfo[imageIndex].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                imageInfo[imageIndex].imageView = bufferInfo.imageView;
-                imageInfo[imageIndex].sampler = bufferInfo.imageSampler;
-
-                VkWriteDescriptorSet descriptorWrite = {};
-                descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrite.dstSet = m_DescriptorSets;
-                descriptorWrite.dstBinding = bufferInfo.binding;
-                descriptorWrite.dstArrayElement = 0;
-                descriptorWrite.descriptorType = bufferInfo.type;
-                descriptorWrite.descriptorCount = bufferInfo.descriptorCount;
-                descriptorWrite.pImageInfo = imageInfo.data();
-
-                descriptorWrites.push_back(descriptorWrite);
-                imageIndex++;
+            bool isImage = bufferInfo.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            if (isImage) {
+                m_ImageWrites.push_back({bufferInfo.imageSampler, bufferInfo.imageView,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+            } else {
+                m_BufferWrites.push_back({bufferInfo.buffer, bufferInfo.offset, bufferInfo.size});
             }
-            else {
-                bInfo[bufferIndex].buffer = bufferInfo.buffer;
-                bInfo[bufferIndex].offset = bufferInfo.offset;
-                bInfo[bufferIndex].range = bufferInfo.size;
-
-                VkWriteDescriptorSet descriptorWrite = {};
-                descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrite.dstSet = m_DescriptorSets;
-                descriptorWrite.dstBinding = bufferInfo.binding;
-                descriptorWrite.descriptorType = bufferInfo.type;
-                descriptorWrite.descriptorCount = bufferInfo.descriptorCount;
-                descriptorWrite.pBufferInfo = &bInfo[bufferIndex];
-
-                descriptorWrites.push_back(descriptorWrite);
-                bufferIndex++;
+
+            // Next element of the array the previous write started
+            if (!m_Writes.empty() && m_Writes.back().dstBinding == static_cast<uint32_t>(bufferInfo.binding) &&
+                m_Writes.back().descriptorType == bufferInfo.type) {
+                m_Writes.back().descriptorCount++;
+                continue;
+            }
+
+            VkWriteDescriptorSet descriptorWrite = {};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = m_DescriptorSets;
+            descriptorWrite.dstBinding = bufferInfo.binding;
+            descriptorWrite.dstArrayElement = 0;
+            descriptorWrite.descriptorType = bufferInfo.type;
+            descriptorWrite.descriptorCount = 1;
+            if (isImage) {
+                descriptorWrite.pImageInfo = &m_ImageWrites.back();
+            } else {
+                descriptorWrite.pBufferInfo = &m_BufferWrites.back();
             }
+            m_Writes.push_back(descriptorWrite);
         }
-        vkUpdateDescriptorSets(Devices::instance()->getDevice(),
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
     }
 }
@@ -3,6 +3,7 @@
 
 #include "Graphics/Vulkan/Vk.h"
 #include "Graphics/Vulkan/Pipeline.h"
+#include "Graphics/Vulkan/CommandBuffer.h"
 
 #include <vector>
 
@@ -11,9 +12,12 @@ namespace Yare {
 
         struct DescriptorSetInfo {
             Pipeline* pipeline;
-            size_t descriptorSetCount;
+            // Transient sets are allocated from the current frame's allocator on every update and are
+            // only valid for that frame, persistent sets are allocated once and rewritten in place
+            bool transient = false;
         };
 
+        // Consecutive entries with the same binding fill consecutive elements of an array binding
         struct BufferInfo {
             VkBuffer buffer;
             VkDescriptorType type;
@@ -22,7 +26,8 @@ namespace Yare {
             uint32_t offset;
             uint32_t size;
             int binding;
-            uint32_t descriptorCount;
+
+            bool operator==(const BufferInfo& other) const;
         };
 
         class DescriptorSet {
@@ -31,12 +36,32 @@ namespace Yare {
             ~DescriptorSet();
 
             void init(const DescriptorSetInfo& descriptorSetInfo);
-            void update(std::vector<BufferInfo>& newBufferInfo);
+            // Persistent sets skip the write when nothing changed since the last update. The write
+            // arrays are reused between updates, so only the first one allocates.
+            void update(const std::vector<BufferInfo>& newBufferInfo);
+            // Binds the set, or pushes its writes when the pipeline uses push descriptors
+            void bind(const CommandBuffer& commandBuffer, uint32_t dynamicOffsetCount = 0,
+                      const uint32_t* dynamicOffsets = nullptr) const;
 
             const VkDescriptorSet& getDescriptorSet(unsigned int index) const { return m_DescriptorSets; }
 
+            // vkCmdPushDescriptorSetKHR is not exported by the loader, it is fetched once the device exists
+            static void loadFunctions(VkDevice device);
+
+        private:
+            void buildWrites(const std::vector<BufferInfo>& newBufferInfo);
+
         private:
-           VkDescriptorSet m_DescriptorSets;
+            Pipeline* m_Pipeline = nullptr;
+            bool m_Transient = false;
+            VkDescriptorSet m_DescriptorSets = VK_NULL_HANDLE;
+
+            std::vector<BufferInfo> m_BufferInfos;
+            std::vector<VkWriteDescriptorSet> m_Writes;
+            std::vector<VkDescriptorBufferInfo> m_BufferWrites;
+            std::vector<VkDescriptorImageInfo> m_ImageWrites;
+
+            static PFN_vkCmdPushDescriptorSetKHR s_CmdPushDescriptorSet;
         };
     }
 }
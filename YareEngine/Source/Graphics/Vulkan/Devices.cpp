@@ -1,8 +1,11 @@
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/TimelineSemaphore.h"
+#include "Graphics/Vulkan/DescriptorSet.h"
 #include "Application/Application.h"
 #include "Utilities/Logger.h"
 #include "Core/Glfw.h"
 
+#include <cstring>
 #include <set>
 
 namespace Yare::Graphics {
@@ -19,14 +22,17 @@ namespace Yare::Graphics {
         }
     }
 
-    void Devices::init(VkInstance instance) {
+    void Devices::init(VkInstance instance, bool headless) {
         if (m_Surface || m_Device || m_PhysicalDevice) {
             YZ_INFO("Device has already been initialized.");
             return;
         }
         m_InstanceRef = instance;
+        m_Headless = headless;
         // Surface must be created before picking a physical device
-        createSurface();
+        if (!m_Headless) {
+            createSurface();
+        }
         // Pick a Gpu that is suitable for rendering
         pickPhysicalDevice();
         // Create a logical device, such that we can interface with the physical device we selected
@@ -86,16 +92,35 @@ namespace Yare::Graphics {
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
+        VkPhysicalDeviceFeatures supportedFeatures;
+        vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+
         VkPhysicalDeviceFeatures deviceFeatures = {};
         deviceFeatures.samplerAnisotropy = VK_TRUE;
+        // Optional, virtual texture feedback is written from fragment shaders
+        deviceFeatures.fragmentStoresAndAtomics = supportedFeatures.fragmentStoresAndAtomics;
+        // Optional, only queried when the render statistics ask for them
+        deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+        m_EnabledFeatures = deviceFeatures;
+
+        // Frame and upload synchronization is built on timeline semaphores
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = {};
+        timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineFeatures.timelineSemaphore = VK_TRUE;
+
         VkDeviceCreateInfo createInfo = {};
 
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = &timelineFeatures;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
-        createInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
+        m_EnabledExtensions = getRequiredExtensions();
+        for (auto extension : getSupportedOptionalExtensions(m_PhysicalDevice)) {
+            m_EnabledExtensions.push_back(extension);
+        }
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(m_EnabledExtensions.size());
+        createInfo.ppEnabledExtensionNames = m_EnabledExtensions.data();
 
         ////To support older implementations of vulkan
         //if (enableValidationLayers) {
@@ -111,22 +136,49 @@ namespace Yare::Graphics {
 
         vkGetDeviceQueue(m_Device, indices.graphicsFamily, 0, &m_GraphicsQueue);
         vkGetDeviceQueue(m_Device, indices.presentFamily, 0, &m_PresentQueue);
+
+        TimelineSemaphore::loadFunctions(m_Device);
+        if (isPushDescriptorSupported()) {
+            DescriptorSet::loadFunctions(m_Device);
+        }
+    }
+
+    bool Devices::isExtensionEnabled(const char* extensionName) const {
+        for (auto extension : m_EnabledExtensions) {
+            if (std::strcmp(extension, extensionName) == 0) {
+                return true;
+            }
+        }
+        return false;
     }
 
     bool Devices::isDeviceSuitable(VkPhysicalDevice device) {
         QueueFamilyIndices indices = findQueueFamilies(device);
 
         bool extensionsSupported = checkDeviceExtensionSupport(device);
-        bool swapChainAdequate = false;
+        bool swapChainAdequate = m_Headless;
 
-        if (extensionsSupported) {
+        if (extensionsSupported && !m_Headless) {
             SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
             swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
         }
-        VkPhysicalDeviceFeatures supportedFeatures;
-        vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
+        // vkGetPhysicalDeviceFeatures2 is core in Vulkan 1.1, a 1.0 device can't be asked for the timeline feature
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+        if (properties.apiVersion < VK_API_VERSION_1_1) {
+            return false;
+        }
+
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = {};
+        timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures = {};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = extensionsSupported ? &timelineFeatures : nullptr;
+        vkGetPhysicalDeviceFeatures2(device, &supportedFeatures);
 
-        return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+        return indices.isComplete() && extensionsSupported && swapChainAdequate &&
+               supportedFeatures.features.samplerAnisotropy && timelineFeatures.timelineSemaphore;
     }
 
     bool Devices::checkDeviceExtensionSupport(VkPhysicalDevice device) {
@@ -136,7 +188,8 @@ namespace Yare::Graphics {
         std::vector<VkExtensionProperties> availableExtensions(extensionCount);
         vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-        std::set<std::string> requiredExtensions(m_DeviceExtensions.begin(), m_DeviceExtensions.end());
+        auto deviceExtensions = getRequiredExtensions();
+        std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 
         for (const auto& extension : availableExtensions) {
             requiredExtensions.erase(extension.extensionName);
@@ -145,6 +198,35 @@ namespace Yare::Graphics {
         return requiredExtensions.empty();
     }
 
+    std::vector<const char*> Devices::getRequiredExtensions() const {
+        std::vector<const char*> extensions;
+        for (auto extension : m_DeviceExtensions) {
+            if (!m_Headless || std::strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) != 0) {
+                extensions.push_back(extension);
+            }
+        }
+        return extensions;
+    }
+
+    std::vector<const char*> Devices::getSupportedOptionalExtensions(VkPhysicalDevice device) {
+        uint32_t extensionCount;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+        std::vector<const char*> supportedExtensions;
+        for (auto optionalExtension : m_OptionalExtensions) {
+            for (const auto& extension : availableExtensions) {
+                if (std::strcmp(extension.extensionName, optionalExtension) == 0) {
+                    supportedExtensions.push_back(optionalExtension);
+                    break;
+                }
+            }
+        }
+        return supportedExtensions;
+    }
+
     QueueFamilyIndices Devices::findQueueFamilies(VkPhysicalDevice device) {
         QueueFamilyIndices indices;
         uint32_t queueFamilyCount = 0;
@@ -157,7 +239,12 @@ namespace Yare::Graphics {
         for (const auto& queueFamily : queueFamilies) {
             VkBool32 presentSupport = false;
 
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+            // Nothing is presented without a surface, the graphics queue stands in for the present queue
+            if (m_Headless) {
+                presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            } else {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+            }
 
             if (indices.presentFamily < 0 && presentSupport) {
                 indices.presentFamily = i;
@@ -28,7 +28,8 @@ namespace Yare::Graphics {
     public:
         Devices();
         ~Devices();
-        void init(VkInstance instance);
+        // A headless device has no surface and does not require presentation support
+        void init(VkInstance instance, bool headless = false);
 
         void waitIdle();
 
@@ -38,6 +39,9 @@ namespace Yare::Graphics {
         const VkQueue& getGraphicsQueue()       const { return m_GraphicsQueue; }
         const VkQueue& getPresentQueue()        const { return m_PresentQueue; }
         const VkPhysicalDeviceProperties& getGPUProperties() const { return m_PhysicalDeviceProperties; }
+        const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return m_EnabledFeatures; }
+        bool isExtensionEnabled(const char* extensionName) const;
+        bool isPushDescriptorSupported() const { return isExtensionEnabled(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME); }
 
         QueueFamilyIndices getQueueFamilyIndicies();
         SwapChainSupportDetails getSwapChainSupport();
@@ -48,6 +52,8 @@ namespace Yare::Graphics {
         void createLogicalDevice();
         bool isDeviceSuitable(VkPhysicalDevice device);
         bool checkDeviceExtensionSupport(VkPhysicalDevice device);
+        std::vector<const char*> getRequiredExtensions() const;
+        std::vector<const char*> getSupportedOptionalExtensions(VkPhysicalDevice device);
         QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
         SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 
@@ -56,13 +62,22 @@ namespace Yare::Graphics {
         VkDevice m_Device                   = VK_NULL_HANDLE;
         VkPhysicalDevice m_PhysicalDevice   = VK_NULL_HANDLE;
         VkPhysicalDeviceProperties m_PhysicalDeviceProperties{};
+        VkPhysicalDeviceFeatures m_EnabledFeatures{};
         VkQueue m_GraphicsQueue             = VK_NULL_HANDLE;
         VkQueue m_PresentQueue              = VK_NULL_HANDLE;
 
         VkInstance m_InstanceRef = VK_NULL_HANDLE;
+        bool m_Headless = false;
+        std::vector<const char*> m_EnabledExtensions;
 
+        // The swapchain extension is only required when presenting to a surface
         const std::vector<const char*> m_DeviceExtensions{
-                                                          VK_KHR_SWAPCHAIN_EXTENSION_NAME
+                                                          VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+                                                          VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
+        };
+        // Enabled when present, check isExtensionEnabled before relying on them
+        const std::vector<const char*> m_OptionalExtensions{
+                                                          VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME
         };
     };
 }
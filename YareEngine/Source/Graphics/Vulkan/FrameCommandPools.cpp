@@ -0,0 +1,50 @@
+#include "Graphics/Vulkan/FrameCommandPools.h"
+
+namespace Yare::Graphics {
+
+    FrameCommandPools::FrameCommandPools(uint32_t frameCount, uint32_t threadCount)
+        : m_ThreadCount(threadCount), m_Pools(frameCount * threadCount) {
+        // Buffers are only ever reset through their pool and live for a single frame
+        for (auto& pool : m_Pools) {
+            pool.commandPool = new CommandPool(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        }
+    }
+
+    FrameCommandPools::~FrameCommandPools() {
+        for (auto& pool : m_Pools) {
+            for (auto commandBuffer : pool.primaryBuffers) {
+                delete commandBuffer;
+            }
+            for (auto commandBuffer : pool.secondaryBuffers) {
+                delete commandBuffer;
+            }
+            delete pool.commandPool;
+        }
+    }
+
+    void FrameCommandPools::beginFrame(uint32_t frameIndex) {
+        m_CurrentFrame = frameIndex;
+        for (uint32_t thread = 0; thread < m_ThreadCount; thread++) {
+            auto& pool = m_Pools[m_CurrentFrame * m_ThreadCount + thread];
+            // Pools nothing was allocated from this time round have nothing to reset
+            if (pool.usedPrimary == 0 && pool.usedSecondary == 0) {
+                continue;
+            }
+            pool.commandPool->reset();
+            pool.usedPrimary = 0;
+            pool.usedSecondary = 0;
+        }
+    }
+
+    CommandBuffer* FrameCommandPools::getCommandBuffer(uint32_t thread, VkCommandBufferLevel level) {
+        auto& pool = m_Pools[m_CurrentFrame * m_ThreadCount + thread];
+        bool primary = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        auto& buffers = primary ? pool.primaryBuffers : pool.secondaryBuffers;
+        auto& used = primary ? pool.usedPrimary : pool.usedSecondary;
+
+        if (used == buffers.size()) {
+            buffers.push_back(new CommandBuffer(pool.commandPool, level));
+        }
+        return buffers[used++];
+    }
+}
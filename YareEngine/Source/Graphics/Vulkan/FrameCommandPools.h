@@ -0,0 +1,45 @@
+#ifndef YARE_FRAME_COMMAND_POOLS_H
+#define YARE_FRAME_COMMAND_POOLS_H
+
+#include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/CommandPool.h"
+#include "Graphics/Vulkan/CommandBuffer.h"
+
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // One transient command pool per recording thread for every frame in flight. The pools of a frame
+    // are reset in bulk when the frame begins again and the command buffers allocated from them are
+    // handed out again instead of being freed. Each thread only touches its own pool, so recording on
+    // several threads needs no locking.
+    class FrameCommandPools {
+    public:
+        FrameCommandPools(uint32_t frameCount, uint32_t threadCount);
+        ~FrameCommandPools();
+
+        // Resets every pool of the frame, the previous submission of that frame must have completed
+        void beginFrame(uint32_t frameIndex);
+
+        // Returns a command buffer of the current frame for the given thread, valid until the frame begins again
+        CommandBuffer* getCommandBuffer(uint32_t thread = 0, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        uint32_t getThreadCount() const { return m_ThreadCount; }
+
+    private:
+        struct ThreadPool {
+            CommandPool* commandPool = nullptr;
+            std::vector<CommandBuffer*> primaryBuffers;
+            std::vector<CommandBuffer*> secondaryBuffers;
+            size_t usedPrimary = 0;
+            size_t usedSecondary = 0;
+        };
+
+        uint32_t m_ThreadCount;
+        uint32_t m_CurrentFrame = 0;
+        // Indexed by frame * m_ThreadCount + thread
+        std::vector<ThreadPool> m_Pools;
+    };
+}
+
+#endif // YARE_FRAME_COMMAND_POOLS_H
@@ -0,0 +1,281 @@
+#include "Graphics/Vulkan/FrameReadback.h"
+#include "Utilities/ImageWriter.h"
+#include "Utilities/Logger.h"
+#include "Utilities/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Yare::Graphics {
+
+    namespace {
+        // Returns false for formats that can't be written out as 8 bit RGBA
+        bool isReadableFormat(VkFormat format, bool& swizzle) {
+            switch (format) {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                swizzle = false;
+                return true;
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                swizzle = true;
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    FrameReadback::FrameReadback(const std::shared_ptr<TimelineSemaphore>& frameTimeline, uint32_t slotCount,
+                                 uint32_t workerCount)
+        : m_FrameTimeline(frameTimeline), m_Slots(std::max(slotCount, 1u)) {
+        for (uint32_t i = 0; i < std::max(workerCount, 1u); i++) {
+            m_Workers.emplace_back(&FrameReadback::workerLoop, this);
+        }
+    }
+
+    FrameReadback::~FrameReadback() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Running = false;
+        }
+        m_JobCondition.notify_all();
+        for (auto& worker : m_Workers) {
+            worker.join();
+        }
+        for (auto& slot : m_Slots) {
+            delete slot.buffer;
+        }
+    }
+
+    bool FrameReadback::record(CommandBuffer& commandBuffer, const RenderTarget& target, uint32_t imageIndex,
+                               const std::string& filePath) {
+        bool swizzle = false;
+        if (!target.isReadable() || !isReadableFormat(target.getImageFormat(), swizzle)) {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        auto slot = acquireSlot(lock);
+        if (slot == nullptr) {
+            return false;
+        }
+
+        auto extent = target.getExtent();
+        size_t size = static_cast<size_t>(extent.width) * extent.height * 4;
+        if (slot->buffer == nullptr || slot->buffer->getSize() != size) {
+            // Free slots are neither read by the GPU nor by a worker
+            delete slot->buffer;
+            slot->buffer = new Buffer(BufferUsage::READBACK, size, nullptr);
+            // Stays mapped for as long as the slot lives
+            slot->buffer->mapMemory(VK_WHOLE_SIZE, 0);
+        }
+        slot->extent = extent;
+        slot->swizzle = swizzle;
+        slot->filePath = filePath;
+        slot->state = SlotState::Recorded;
+        if (m_FirstRecord == std::chrono::steady_clock::time_point()) {
+            m_FirstRecord = std::chrono::steady_clock::now();
+        }
+        lock.unlock();
+
+        // Swapchain images have to leave the present layout for the copy and return to it afterwards
+        auto finalLayout = target.getFinalLayout();
+        bool transition = finalLayout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout = finalLayout;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = target.getImage(imageIndex);
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region = {};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {extent.width, extent.height, 1};
+        vkCmdCopyImageToBuffer(commandBuffer.getCommandBuffer(), target.getImage(imageIndex),
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot->buffer->getBuffer(), 1, &region);
+
+        if (transition) {
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = finalLayout;
+            vkCmdPipelineBarrier(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+
+        // The host waits on the frame timeline before reading, this makes the copy visible to it
+        VkMemoryBarrier hostBarrier = {};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+        return true;
+    }
+
+    void FrameReadback::submitted(uint64_t timelineValue) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto& slot : m_Slots) {
+            if (slot.state == SlotState::Recorded) {
+                slot.state = SlotState::InFlight;
+                slot.timelineValue = timelineValue;
+            }
+        }
+    }
+
+    void FrameReadback::update() {
+        std::vector<Result> results;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto completedValue = m_FrameTimeline->getCompletedValue();
+            for (auto& slot : m_Slots) {
+                if (slot.state == SlotState::InFlight && slot.timelineValue <= completedValue) {
+                    dispatch(slot);
+                }
+            }
+            results.swap(m_Results);
+        }
+
+        for (const auto& result : results) {
+            if (!result.success) {
+                YZ_WARN("Could not write the captured frame to " + result.filePath);
+            }
+        }
+    }
+
+    void FrameReadback::flush() {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            for (auto& slot : m_Slots) {
+                if (slot.state == SlotState::InFlight) {
+                    auto value = slot.timelineValue;
+                    lock.unlock();
+                    m_FrameTimeline->wait(value);
+                    lock.lock();
+                    dispatch(slot);
+                }
+            }
+            m_SlotCondition.wait(lock, [this] { return m_Writing == 0; });
+        }
+        update();
+    }
+
+    FrameReadback::Statistics FrameReadback::getStatistics() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto statistics = m_Statistics;
+        if (statistics.captured + statistics.failed > 0) {
+            statistics.seconds = std::chrono::duration<double>(m_LastWrite - m_FirstRecord).count();
+        }
+        return statistics;
+    }
+
+    double FrameReadback::getCaptureRate() const {
+        auto statistics = getStatistics();
+        return statistics.seconds > 0.0 ? statistics.captured / statistics.seconds : 0.0;
+    }
+
+    FrameReadback::Slot* FrameReadback::acquireSlot(std::unique_lock<std::mutex>& lock) {
+        bool stalled = false;
+        while (true) {
+            for (auto& slot : m_Slots) {
+                if (slot.state == SlotState::Free) {
+                    return &slot;
+                }
+            }
+
+            if (!stalled) {
+                m_Statistics.stalls++;
+                stalled = true;
+            }
+
+            // Nothing will free a slot unless the oldest copy is handed to a worker
+            Slot* oldest = nullptr;
+            bool writing = false;
+            for (auto& slot : m_Slots) {
+                if (slot.state == SlotState::InFlight && (!oldest || slot.timelineValue < oldest->timelineValue)) {
+                    oldest = &slot;
+                }
+                writing |= slot.state == SlotState::Writing;
+            }
+            if (oldest != nullptr) {
+                auto value = oldest->timelineValue;
+                lock.unlock();
+                m_FrameTimeline->wait(value);
+                lock.lock();
+                if (oldest->state == SlotState::InFlight) {
+                    dispatch(*oldest);
+                }
+            } else if (!writing) {
+                // Every slot was recorded this frame
+                return nullptr;
+            }
+
+            m_SlotCondition.wait(lock, [this] {
+                return std::any_of(m_Slots.begin(), m_Slots.end(),
+                                   [](const Slot& slot) { return slot.state == SlotState::Free; });
+            });
+        }
+    }
+
+    void FrameReadback::dispatch(Slot& slot) {
+        slot.state = SlotState::Writing;
+        m_Jobs.push_back(&slot);
+        m_Writing++;
+        m_JobCondition.notify_one();
+    }
+
+    void FrameReadback::workerLoop() {
+        YZ_PROFILE_THREAD("Frame readback");
+        while (true) {
+            Slot* slot;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_JobCondition.wait(lock, [this] { return !m_Running || !m_Jobs.empty(); });
+                if (m_Jobs.empty()) {
+                    return;
+                }
+                slot = m_Jobs.front();
+                m_Jobs.pop_front();
+            }
+
+            YZ_PROFILE_SCOPE("Write capture");
+            // Only this worker touches a slot while it is being written. Reading host visible memory
+            // piecemeal is slow, so it is copied out in one go, which also frees the slot before encoding.
+            auto extent = slot->extent;
+            bool swizzle = slot->swizzle;
+            auto filePath = std::move(slot->filePath);
+            std::vector<uint8_t> pixels(slot->buffer->getSize());
+            std::memcpy(pixels.data(), slot->buffer->getMappedData(), pixels.size());
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                slot->state = SlotState::Free;
+            }
+            m_SlotCondition.notify_all();
+
+            if (swizzle) {
+                for (size_t i = 0; i < pixels.size(); i += 4) {
+                    std::swap(pixels[i], pixels[i + 2]);
+                }
+            }
+            bool success = Utilities::writeImage(filePath, extent.width, extent.height, pixels.data());
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Results.push_back({filePath, success});
+                success ? m_Statistics.captured++ : m_Statistics.failed++;
+                m_LastWrite = std::chrono::steady_clock::now();
+                m_Writing--;
+            }
+            m_SlotCondition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef YARE_FRAME_READBACK_H
+#define YARE_FRAME_READBACK_H
+
+#include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/Buffer.h"
+#include "Graphics/Vulkan/CommandBuffer.h"
+#include "Graphics/Vulkan/RenderTarget.h"
+#include "Graphics/Vulkan/TimelineSemaphore.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Copies rendered images into a ring of host visible buffers and writes them to disk on worker threads.
+    // The copy is recorded into the frame's command buffer and only read once the frame timeline shows it
+    // has completed, a few frames later, so capturing a frame does not stall the render loop.
+    class FrameReadback {
+    public:
+        struct Statistics {
+            uint32_t captured = 0;
+            uint32_t failed = 0;
+            // Times record had to wait for a slot, the ring is too small or the workers too slow
+            uint32_t stalls = 0;
+            // From the first recorded copy to the last written file
+            double   seconds = 0.0;
+        };
+
+        FrameReadback(const std::shared_ptr<TimelineSemaphore>& frameTimeline, uint32_t slotCount,
+                      uint32_t workerCount);
+        // Writes out everything that was recorded and submitted
+        ~FrameReadback();
+
+        // Records copying the image into a free slot, waits for one if all are in use.
+        // Returns false if the target's images can't be read back.
+        bool record(CommandBuffer& commandBuffer, const RenderTarget& target, uint32_t imageIndex,
+                    const std::string& filePath);
+        // Tags the copies recorded this frame with the timeline value its submission signals
+        void submitted(uint64_t timelineValue);
+        // Hands completed copies to the workers and reports failed writes, called once per frame
+        void update();
+        // Blocks until every submitted copy has been written
+        void flush();
+
+        Statistics getStatistics() const;
+        // Captured frames per second, over the time captures were being taken
+        double getCaptureRate() const;
+
+    private:
+        enum class SlotState { Free, Recorded, InFlight, Writing };
+
+        struct Slot {
+            Buffer*     buffer = nullptr;
+            VkExtent2D  extent = {0, 0};
+            // BGRA images are written out as RGBA
+            bool        swizzle = false;
+            std::string filePath;
+            uint64_t    timelineValue = 0;
+            SlotState   state = SlotState::Free;
+        };
+
+        struct Result {
+            std::string filePath;
+            bool        success;
+        };
+
+        Slot* acquireSlot(std::unique_lock<std::mutex>& lock);
+        // Requires the lock, the slot's frame has to have completed
+        void  dispatch(Slot& slot);
+        void  workerLoop();
+
+    private:
+        std::shared_ptr<TimelineSemaphore> m_FrameTimeline;
+        std::vector<Slot>                  m_Slots;
+
+        std::vector<std::thread>           m_Workers;
+        bool                               m_Running = true;
+        mutable std::mutex                 m_Mutex;
+        std::condition_variable            m_JobCondition;
+        // Signalled by the workers whenever a slot is freed or a file written
+        std::condition_variable            m_SlotCondition;
+        std::deque<Slot*>                  m_Jobs;
+        // Files being encoded, their slots may already have been reused
+        uint32_t                           m_Writing = 0;
+        // Files the workers finished, update reports the ones that could not be written
+        std::vector<Result>                m_Results;
+
+        Statistics                                     m_Statistics;
+        std::chrono::steady_clock::time_point          m_FirstRecord;
+        std::chrono::steady_clock::time_point          m_LastWrite;
+    };
+}
+
+#endif // YARE_FRAME_READBACK_H
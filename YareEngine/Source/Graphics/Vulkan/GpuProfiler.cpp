@@ -0,0 +1,219 @@
+#include "Graphics/Vulkan/GpuProfiler.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+namespace Yare::Graphics {
+
+    GpuProfiler::Scope::Scope(GpuProfiler& profiler, CommandBuffer& commandBuffer, const std::string& name)
+        : m_Profiler(profiler), m_CommandBuffer(commandBuffer) {
+        m_Profiler.beginScope(m_CommandBuffer, name);
+    }
+
+    GpuProfiler::Scope::~Scope() {
+        m_Profiler.endScope(m_CommandBuffer);
+    }
+
+    GpuProfiler::GpuProfiler(uint32_t framesInFlight, uint32_t maxScopes)
+        : m_Frames(framesInFlight), m_MaxQueries(maxScopes * 2) {
+        auto devices = Devices::instance();
+
+        m_StatisticsSupported = devices->getEnabledFeatures().pipelineStatisticsQuery;
+        if (m_StatisticsSupported) {
+            VkQueryPoolCreateInfo statisticsInfo = {};
+            statisticsInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            statisticsInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            statisticsInfo.queryCount = 1;
+            // Written to the results in the order of the bits
+            statisticsInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+                                                VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                                                VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                                                VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+            for (auto& frame : m_Frames) {
+                if (vkCreateQueryPool(devices->getDevice(), &statisticsInfo, nullptr, &frame.statisticsPool) != VK_SUCCESS) {
+                    YZ_CRITICAL("Vulkan failed to create a pipeline statistics query pool.");
+                }
+            }
+        }
+
+        auto graphicsFamily = devices->getQueueFamilyIndicies().graphicsFamily;
+
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(devices->getGPU(), &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(devices->getGPU(), &familyCount, families.data());
+
+        auto validBits = families[graphicsFamily].timestampValidBits;
+        m_TimestampPeriod = devices->getGPUProperties().limits.timestampPeriod;
+        m_Supported = validBits > 0 && m_TimestampPeriod > 0.0;
+        if (!m_Supported) {
+            YZ_WARN("The graphics queue does not support timestamps, GPU timings are disabled");
+            return;
+        }
+        m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+        VkQueryPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = m_MaxQueries;
+        for (auto& frame : m_Frames) {
+            if (vkCreateQueryPool(devices->getDevice(), &poolInfo, nullptr, &frame.pool) != VK_SUCCESS) {
+                YZ_CRITICAL("Vulkan failed to create a timestamp query pool.");
+            }
+        }
+    }
+
+    GpuProfiler::~GpuProfiler() {
+        for (auto& frame : m_Frames) {
+            if (frame.pool) {
+                vkDestroyQueryPool(Devices::instance()->getDevice(), frame.pool, nullptr);
+            }
+            if (frame.statisticsPool) {
+                vkDestroyQueryPool(Devices::instance()->getDevice(), frame.statisticsPool, nullptr);
+            }
+        }
+    }
+
+    void GpuProfiler::beginFrame(CommandBuffer& commandBuffer, uint32_t frameIndex, bool pipelineStatistics) {
+        auto& frame = m_Frames[frameIndex % m_Frames.size()];
+        collectPipelineStatistics(frame);
+        m_StatisticsReset = m_StatisticsSupported && pipelineStatistics;
+        if (m_StatisticsReset) {
+            vkCmdResetQueryPool(commandBuffer.getCommandBuffer(), frame.statisticsPool, 0, 1);
+        }
+
+        if (!m_Supported) {
+            m_Current = &frame;
+            return;
+        }
+        collect(frame);
+
+        vkCmdResetQueryPool(commandBuffer.getCommandBuffer(), frame.pool, 0, m_MaxQueries);
+        frame.frameNumber = m_FrameNumber++;
+        frame.queryCount = 0;
+        frame.scopes.clear();
+        m_Current = &frame;
+        m_OpenScopes.clear();
+
+        beginScope(commandBuffer, "Frame");
+    }
+
+    void GpuProfiler::endFrame(CommandBuffer& commandBuffer) {
+        if (!m_Current) {
+            return;
+        }
+        // Scopes left open are closed with the frame
+        while (!m_OpenScopes.empty()) {
+            endScope(commandBuffer);
+        }
+        endPipelineStatistics(commandBuffer);
+        m_Current = nullptr;
+    }
+
+    void GpuProfiler::beginScope(CommandBuffer& commandBuffer, const std::string& name) {
+        if (!m_Current || !m_Supported) {
+            return;
+        }
+        // Scopes that don't fit are dropped, the marker keeps the matching endScope from closing another one
+        if (m_Current->queryCount + 2 > m_MaxQueries) {
+            m_OpenScopes.push_back(DROPPED_SCOPE);
+            return;
+        }
+
+        auto query = m_Current->queryCount;
+        m_Current->queryCount += 2;
+        m_OpenScopes.push_back(static_cast<uint32_t>(m_Current->scopes.size()));
+        m_Current->scopes.push_back({name, static_cast<uint32_t>(m_OpenScopes.size() - 1), query});
+        vkCmdWriteTimestamp(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                            m_Current->pool, query);
+    }
+
+    void GpuProfiler::endScope(CommandBuffer& commandBuffer) {
+        if (!m_Current || m_OpenScopes.empty()) {
+            return;
+        }
+        auto index = m_OpenScopes.back();
+        m_OpenScopes.pop_back();
+        if (index == DROPPED_SCOPE) {
+            return;
+        }
+        auto& scope = m_Current->scopes[index];
+        vkCmdWriteTimestamp(commandBuffer.getCommandBuffer(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                            m_Current->pool, scope.query + 1);
+    }
+
+    void GpuProfiler::beginPipelineStatistics(CommandBuffer& commandBuffer) {
+        if (!m_Current || !m_StatisticsReset || m_StatisticsOpen) {
+            return;
+        }
+        vkCmdBeginQuery(commandBuffer.getCommandBuffer(), m_Current->statisticsPool, 0, 0);
+        m_Current->statisticsRecorded = true;
+        m_StatisticsOpen = true;
+    }
+
+    void GpuProfiler::endPipelineStatistics(CommandBuffer& commandBuffer) {
+        if (!m_Current || !m_StatisticsOpen) {
+            return;
+        }
+        vkCmdEndQuery(commandBuffer.getCommandBuffer(), m_Current->statisticsPool, 0);
+        m_StatisticsOpen = false;
+    }
+
+    bool GpuProfiler::openCsvLog(const std::string& filePath) {
+        m_CsvLog.open(filePath);
+        if (!m_CsvLog) {
+            YZ_WARN("Could not open " + filePath + " for the GPU timings");
+            return false;
+        }
+        m_CsvLog << "frame,scope,depth,milliseconds\n";
+        return true;
+    }
+
+    void GpuProfiler::collect(Frame& frame) {
+        if (frame.queryCount == 0) {
+            return;
+        }
+
+        // Every query is followed by its availability, unavailable ones are skipped instead of waited on
+        std::vector<uint64_t> data(frame.queryCount * 2);
+        vkGetQueryPoolResults(Devices::instance()->getDevice(), frame.pool, 0, frame.queryCount,
+                              data.size() * sizeof(uint64_t), data.data(), 2 * sizeof(uint64_t),
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        m_Results.clear();
+        for (const auto& scope : frame.scopes) {
+            auto begin = scope.query * 2;
+            auto end = (scope.query + 1) * 2;
+            if (data[begin + 1] == 0 || data[end + 1] == 0) {
+                continue;
+            }
+            auto ticks = (data[end] - data[begin]) & m_TimestampMask;
+            double milliseconds = ticks * m_TimestampPeriod / 1000000.0;
+            m_Results.push_back({scope.name, scope.depth, milliseconds});
+            if (scope.depth == 0) {
+                m_FrameMilliseconds = milliseconds;
+                m_CollectedFrames++;
+            }
+
+            if (m_CsvLog.is_open()) {
+                m_CsvLog << frame.frameNumber << "," << scope.name << "," << scope.depth << "," << milliseconds << "\n";
+            }
+        }
+    }
+
+    void GpuProfiler::collectPipelineStatistics(Frame& frame) {
+        if (!frame.statisticsRecorded) {
+            return;
+        }
+        frame.statisticsRecorded = false;
+
+        // The four counters followed by the availability
+        uint64_t data[5] = {};
+        vkGetQueryPoolResults(Devices::instance()->getDevice(), frame.statisticsPool, 0, 1, sizeof(data), data,
+                              sizeof(data), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (data[4] == 0) {
+            return;
+        }
+        m_PipelineStatistics = {data[0], data[1], data[2], data[3]};
+        m_HasPipelineStatistics = true;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef YARE_GPU_PROFILER_H
+#define YARE_GPU_PROFILER_H
+
+#include "Core/Core.h"
+#include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/CommandBuffer.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    struct GpuTiming {
+        std::string name;
+        // Nesting level, the whole frame is 0
+        uint32_t    depth;
+        double      milliseconds;
+    };
+
+    // Counted by the GPU over the frame's render pass
+    struct PipelineStatistics {
+        uint64_t inputPrimitives = 0;
+        uint64_t vertexInvocations = 0;
+        uint64_t clippingPrimitives = 0;
+        uint64_t fragmentInvocations = 0;
+    };
+
+    // Measures GPU time with timestamp queries, one query pool per frame in flight.
+    // A frame's results are read when its pool comes round again, by then the frame has completed
+    // and reading them does not stall. Queries that are not available yet are skipped.
+    // Pipeline statistics are only queried for frames begun with them enabled, they cost some GPU time
+    // and need a device feature.
+    class GpuProfiler {
+    public:
+        // Brackets the commands recorded during its lifetime
+        class Scope {
+        public:
+            Scope(GpuProfiler& profiler, CommandBuffer& commandBuffer, const std::string& name);
+            ~Scope();
+            NONCOPYABLE(Scope)
+
+        private:
+            GpuProfiler&   m_Profiler;
+            CommandBuffer& m_CommandBuffer;
+        };
+
+        GpuProfiler(uint32_t framesInFlight, uint32_t maxScopes = 64);
+        ~GpuProfiler();
+
+        // Reads the results the frame's pool holds and resets it, must be recorded outside a render pass
+        void beginFrame(CommandBuffer& commandBuffer, uint32_t frameIndex, bool pipelineStatistics);
+        void endFrame(CommandBuffer& commandBuffer);
+        void beginScope(CommandBuffer& commandBuffer, const std::string& name);
+        void endScope(CommandBuffer& commandBuffer);
+        // Brackets the commands of one subpass, both must be recorded inside it
+        void beginPipelineStatistics(CommandBuffer& commandBuffer);
+        void endPipelineStatistics(CommandBuffer& commandBuffer);
+
+        // Appends every read back timing to a CSV file with the columns frame, scope, depth, milliseconds
+        bool openCsvLog(const std::string& filePath);
+
+        bool isSupported() const { return m_Supported; }
+        // Timings of the most recent frame that was read back, in the order the scopes began
+        const std::vector<GpuTiming>& getResults() const { return m_Results; }
+        // The whole frame of the most recent results, and how many frames have been read back so far
+        double   getFrameMilliseconds() const { return m_FrameMilliseconds; }
+        uint64_t getCollectedFrames()   const { return m_CollectedFrames; }
+
+        bool isPipelineStatisticsSupported() const { return m_StatisticsSupported; }
+        // The most recent frame that was queried, false until one has been read back
+        bool hasPipelineStatistics() const { return m_HasPipelineStatistics; }
+        const PipelineStatistics& getPipelineStatistics() const { return m_PipelineStatistics; }
+
+    private:
+        struct ScopeRecord {
+            std::string name;
+            uint32_t    depth;
+            uint32_t    query;
+        };
+
+        struct Frame {
+            VkQueryPool              pool = VK_NULL_HANDLE;
+            uint64_t                 frameNumber = 0;
+            uint32_t                 queryCount = 0;
+            std::vector<ScopeRecord> scopes;
+            VkQueryPool              statisticsPool = VK_NULL_HANDLE;
+            bool                     statisticsRecorded = false;
+        };
+
+        void collect(Frame& frame);
+        void collectPipelineStatistics(Frame& frame);
+
+        static constexpr uint32_t DROPPED_SCOPE = UINT32_MAX;
+
+    private:
+        std::vector<Frame>     m_Frames;
+        Frame*                 m_Current = nullptr;
+        // Scopes that began but have not ended yet, as indices into the current frame's scopes
+        std::vector<uint32_t>  m_OpenScopes;
+        uint32_t               m_MaxQueries;
+        uint64_t               m_FrameNumber = 0;
+
+        bool                   m_Supported = false;
+        double                 m_TimestampPeriod = 0.0;
+        uint64_t               m_TimestampMask = 0;
+
+        bool                   m_StatisticsSupported = false;
+        // Whether the current frame's statistics pool was reset, and whether its query is open
+        bool                   m_StatisticsReset = false;
+        bool                   m_StatisticsOpen = false;
+        bool                   m_HasPipelineStatistics = false;
+        PipelineStatistics     m_PipelineStatistics;
+
+        std::vector<GpuTiming> m_Results;
+        double                 m_FrameMilliseconds = 0.0;
+        uint64_t               m_CollectedFrames = 0;
+        std::ofstream          m_CsvLog;
+    };
+}
+
+#endif // YARE_GPU_PROFILER_H
@@ -1,10 +1,12 @@
 #include "Graphics/Vulkan/Image.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
 #include "Graphics/Vulkan/Utilities.h"
 #include "Utilities/Logger.h"
 
 #include <stb/stb_image.h>
 #include <stdlib.h>
+#include <algorithm>
 
 namespace Yare::Graphics {
 
@@ -18,9 +20,6 @@ namespace Yare::Graphics {
         if (m_ImageMemory) {
             vkFreeMemory(Devices::instance()->getDevice(), m_ImageMemory, nullptr);
         }
-        if (m_Sampler) {
-            vkDestroySampler(Devices::instance()->getDevice(), m_Sampler, nullptr);
-        }
     }
 
     void Image::createTexture2DFromFile(const std::string& filePath) {
@@ -65,6 +64,79 @@ namespace Yare::Graphics {
         createSampler(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
     }
 
+    void Image::createTexture2DFromMipChain(size_t width, size_t height, VkFormat format,
+                                            const unsigned char* data, uint32_t mipLevels) {
+        m_TextureWidth = width;
+        m_TextureHeight = height;
+        m_MipLevels = mipLevels;
+
+        VkDeviceSize chainSize = 0;
+        for (uint32_t level = 0; level < mipLevels; level++) {
+            chainSize += std::max<size_t>(width >> level, 1) * std::max<size_t>(height >> level, 1) * 4;
+        }
+
+        Buffer stagingBuffer;
+        stagingBuffer.init(BufferUsage::TRANSFER, chainSize, data);
+
+        createTexture2D(stagingBuffer, format);
+        createSampler(VK_SAMPLER_ADDRESS_MODE_REPEAT);
+    }
+
+    void Image::createUpdatableTexture(size_t width, size_t height, VkFormat format,
+                                       uint32_t mipLevels, VkFilter filter) {
+        m_TextureWidth = width;
+        m_TextureHeight = height;
+        m_MipLevels = mipLevels;
+
+        createImage(VK_IMAGE_TYPE_2D, format,
+                    VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    0,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        m_ImageView = VkUtil::createImageView(m_Image, VK_IMAGE_VIEW_TYPE_2D, format,
+                                              1, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels);
+
+        // Leave the image in the layout updateRegions expects
+        transitionImageLayout(format, 1, VK_IMAGE_LAYOUT_UNDEFINED,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        transitionImageLayout(format, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        createSampler(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, filter);
+    }
+
+    void Image::updateRegions(VkCommandBuffer commandBuffer, const Buffer& buffer,
+                              const std::vector<VkBufferImageCopy>& regions) {
+        if (regions.empty()) {
+            return;
+        }
+
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_Image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        vkCmdCopyBufferToImage(commandBuffer, buffer.getBuffer(), m_Image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
+
+        // Also orders the copy before the sampling of frames submitted after it
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
     void Image::loadTextureFromFileIntoBuffer(const std::string& filePath, Buffer& buffer) {
 
         int texWidth, texHeight, texChannels;
@@ -129,11 +201,11 @@ namespace Yare::Graphics {
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
         m_ImageView = VkUtil::createImageView(m_Image, VK_IMAGE_VIEW_TYPE_2D, format,
-                                              1, VK_IMAGE_ASPECT_COLOR_BIT);
+                                              1, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels);
 
         transitionImageLayout(format, 1, VK_IMAGE_LAYOUT_UNDEFINED,
                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        copyBufferToImage(buffer, 1, 1);
+        copyBufferToImage(buffer, 1, m_MipLevels);
         transitionImageLayout(format, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     }
@@ -167,7 +239,7 @@ namespace Yare::Graphics {
         barrier.image = m_Image;
         barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.levelCount = m_MipLevels;
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = layerCount;
 
@@ -190,6 +262,14 @@ namespace Yare::Graphics {
             sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
             destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
         }
+        else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+                 newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+            barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
         else {
             throw std::invalid_argument("unsupported layout transition!");
         }
@@ -213,21 +293,23 @@ namespace Yare::Graphics {
         std::vector<VkBufferImageCopy> bufferCopyRegions;
 
         for (uint32_t face = 0; face < faces; face++) {
+            // This assumes the buffer has only n required images and nothing more
+            VkDeviceSize offset = (buffer.getSize() / faces) * face;
             for (uint32_t level = 0; level < mipLevels; level++) {
-                // This assumes the buffer has only n required images and nothing more
-                uint32_t offset = (static_cast<uint32_t>(buffer.getSize()) / faces) * face;
+                uint32_t levelWidth = std::max(static_cast<uint32_t>(m_TextureWidth) >> level, 1u);
+                uint32_t levelHeight = std::max(static_cast<uint32_t>(m_TextureHeight) >> level, 1u);
+
                 VkBufferImageCopy bufferCopyRegion = {};
                 bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
                 bufferCopyRegion.imageSubresource.mipLevel = level;
                 bufferCopyRegion.imageSubresource.baseArrayLayer = face;
                 bufferCopyRegion.imageSubresource.layerCount = 1;
-                bufferCopyRegion.imageExtent = {
-                                      static_cast<uint32_t>(m_TextureWidth),
-                                      static_cast<uint32_t>(m_TextureHeight),
-                                      1
-                };
+                bufferCopyRegion.imageExtent = { levelWidth, levelHeight, 1 };
                 bufferCopyRegion.bufferOffset = offset;
                 bufferCopyRegions.push_back(bufferCopyRegion);
+
+                // Mips are packed one after another, RGBA8
+                offset += levelWidth * levelHeight * 4;
             }
         }
 
@@ -247,7 +329,7 @@ namespace Yare::Graphics {
         imageInfo.extent.width = static_cast<uint32_t>(m_TextureWidth);
         imageInfo.extent.height = static_cast<uint32_t>(m_TextureHeight);
         imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
+        imageInfo.mipLevels = m_MipLevels;
         imageInfo.format = format;
         imageInfo.tiling = tiling;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -283,28 +365,9 @@ namespace Yare::Graphics {
         }
     }
 
-    void Image::createSampler(VkSamplerAddressMode mode) {
-        VkSamplerCreateInfo samplerInfo = {};
-        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-        samplerInfo.magFilter = VK_FILTER_LINEAR;
-        samplerInfo.minFilter = VK_FILTER_LINEAR;
-        samplerInfo.addressModeU = mode;
-        samplerInfo.addressModeV = mode;
-        samplerInfo.addressModeW = mode;
-        samplerInfo.anisotropyEnable = VK_TRUE;
-        samplerInfo.maxAnisotropy = 16;
-        samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_WHITE;
-        samplerInfo.unnormalizedCoordinates = VK_FALSE;
-        samplerInfo.compareEnable = VK_FALSE;
-        samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-        samplerInfo.mipLodBias = 0.0f;
-        samplerInfo.minLod = 0.0f;
-        samplerInfo.maxLod = 0.0f;
-
-        if (vkCreateSampler(Devices::instance()->getDevice(), &samplerInfo, nullptr, &m_Sampler) != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan failed to create a sampler.");
-        }
+    void Image::createSampler(VkSamplerAddressMode mode, VkFilter filter) {
+        // Owned by the cache, images with the same sampler state share it
+        m_Sampler = VulkanContext::getContext()->getSamplerCache()->getSampler(SamplerInfo{filter, mode});
     }
 
     Image* Image::createDepthStencilBuffer(size_t width, size_t height, VkFormat format) {
@@ -315,6 +378,14 @@ namespace Yare::Graphics {
         return image;
     }
 
+    Image* Image::createColorAttachment(size_t width, size_t height, VkFormat format) {
+        Image* image = new Image();
+        image->createEmptyTexture(width, height, format, VK_IMAGE_TILING_OPTIMAL,
+                                  VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT);
+        return image;
+    }
+
     Image* Image::createTexture2D(size_t width, size_t height, VkFormat format, unsigned char* data) {
         Image* image = new Image();
         image->createTexture2DFromData(width, height, format, data);
@@ -327,6 +398,20 @@ namespace Yare::Graphics {
         return image;
     }
 
+    Image* Image::createTexture2DMipChain(size_t width, size_t height, VkFormat format,
+                                          const unsigned char* data, uint32_t mipLevels) {
+        Image* image = new Image();
+        image->createTexture2DFromMipChain(width, height, format, data, mipLevels);
+        return image;
+    }
+
+    Image* Image::createUpdatableTexture2D(size_t width, size_t height, VkFormat format,
+                                           uint32_t mipLevels, VkFilter filter) {
+        Image* image = new Image();
+        image->createUpdatableTexture(width, height, format, mipLevels, filter);
+        return image;
+    }
+
     Image* Image::createTextureCube(const std::vector<std::string>& filePaths) {
         Image* image = new Image();
         if (filePaths.empty()) {
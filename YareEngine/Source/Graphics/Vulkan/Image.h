@@ -22,11 +22,21 @@ namespace Yare::Graphics {
                                 VkImageTiling tiling, VkImageUsageFlags usage,
                                 VkMemoryPropertyFlags properties, VkImageAspectFlagBits flagBits);
         void createTexture2DFromData(size_t width, size_t height, VkFormat format, unsigned char* data);
+        void createTexture2DFromMipChain(size_t width, size_t height, VkFormat format,
+                                         const unsigned char* data, uint32_t mipLevels);
+        void createUpdatableTexture(size_t width, size_t height, VkFormat format,
+                                    uint32_t mipLevels, VkFilter filter);
+
+        // Records a copy of regions of a transfer buffer into an image that is currently bound for sampling,
+        // the buffer has to outlive the command buffer
+        void updateRegions(VkCommandBuffer commandBuffer, const Buffer& buffer,
+                           const std::vector<VkBufferImageCopy>& regions);
 
         const VkImage&         getImage()     const { return m_Image; }
         const VkDeviceMemory&  getMemory()    const { return m_ImageMemory; }
         const VkImageView&     getImageView() const { return m_ImageView; }
         const VkSampler&       getSampler()   const { return m_Sampler; }
+        uint32_t               getMipLevels() const { return m_MipLevels; }
 
     private:
         void loadTextureFromFileIntoBuffer(const std::string& filePath, Buffer& buffer);
@@ -40,22 +50,32 @@ namespace Yare::Graphics {
         void createImage(VkImageType type, VkFormat format, VkImageTiling tiling,
                          VkImageUsageFlags usage, VkImageCreateFlags flags,
                          VkMemoryPropertyFlags properties);
-        void createSampler(VkSamplerAddressMode mode);
+        void createSampler(VkSamplerAddressMode mode, VkFilter filter = VK_FILTER_LINEAR);
 
         VkImage         m_Image       = VK_NULL_HANDLE;
         VkDeviceMemory  m_ImageMemory = VK_NULL_HANDLE;
         VkImageView     m_ImageView   = VK_NULL_HANDLE;
+        // Shared through the context's sampler cache
         VkSampler       m_Sampler     = VK_NULL_HANDLE;
 
         size_t m_TextureWidth = 0;
         size_t m_TextureHeight = 0;
         size_t m_TextureChannels = 0;
+        uint32_t m_MipLevels = 1;
 
     public:
         static Image* createDepthStencilBuffer(size_t width, size_t height, VkFormat format);
+        // Rendered to and copied from, never sampled
+        static Image* createColorAttachment(size_t width, size_t height, VkFormat format);
         static Image* createTexture2D(size_t width, size_t height, VkFormat format, unsigned char* data);
         static Image* createTexture2D(const std::string& filePath);
+        // data must hold every level from the base to the smallest mip, tightly packed as RGBA8
+        static Image* createTexture2DMipChain(size_t width, size_t height, VkFormat format,
+                                              const unsigned char* data, uint32_t mipLevels);
         static Image* createTextureCube(const std::vector<std::string>& filePaths);
+        // Contents are undefined until the first updateRegions call
+        static Image* createUpdatableTexture2D(size_t width, size_t height, VkFormat format,
+                                               uint32_t mipLevels, VkFilter filter);
     };
 }
 
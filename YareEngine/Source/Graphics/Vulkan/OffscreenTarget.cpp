@@ -0,0 +1,41 @@
+#include "Graphics/Vulkan/OffscreenTarget.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Utilities/Logger.h"
+
+namespace Yare::Graphics {
+
+    OffscreenTarget::OffscreenTarget(size_t width, size_t height, uint32_t imageCount)
+        : m_Extent{static_cast<uint32_t>(width), static_cast<uint32_t>(height)}, m_ImageCount(imageCount) {
+        createImages();
+        YZ_INFO("Offscreen target created with " + STR(imageCount) + " images of " + STR(width) + "x" + STR(height));
+    }
+
+    OffscreenTarget::~OffscreenTarget() {
+        for (auto image : m_Images) {
+            delete image;
+        }
+    }
+
+    VkResult OffscreenTarget::acquireNextImage(VkSemaphore signalSemaphore) {
+        // The context has already waited for the frame that last rendered into this image
+        m_CurrentImage = (m_CurrentImage + 1) % m_ImageCount;
+        return VK_SUCCESS;
+    }
+
+    void OffscreenTarget::onResize(size_t width, size_t height) {
+        auto& deletionQueue = VulkanContext::getContext()->getDeletionQueue();
+        for (auto image : m_Images) {
+            deletionQueue->destroy(image);
+        }
+        m_Images.clear();
+
+        m_Extent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+        createImages();
+    }
+
+    void OffscreenTarget::createImages() {
+        for (uint32_t i = 0; i < m_ImageCount; i++) {
+            m_Images.push_back(Image::createColorAttachment(m_Extent.width, m_Extent.height, m_Format));
+        }
+    }
+}
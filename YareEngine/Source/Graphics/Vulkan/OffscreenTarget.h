@@ -0,0 +1,46 @@
+#ifndef YARE_OFFSCREEN_TARGET_H
+#define YARE_OFFSCREEN_TARGET_H
+
+#include "Graphics/Vulkan/RenderTarget.h"
+#include "Graphics/Vulkan/Image.h"
+
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Renders into images owned by the engine instead of a swapchain, so frames can be produced
+    // without a window or a surface. Every image is left ready to be copied from.
+    class OffscreenTarget : public RenderTarget {
+    public:
+        // One image per frame in flight, so a frame never renders into an image the GPU still writes
+        OffscreenTarget(size_t width, size_t height, uint32_t imageCount);
+        ~OffscreenTarget();
+
+        VkResult acquireNextImage(VkSemaphore signalSemaphore) override;
+        VkResult present(VkSemaphore waitSemaphore) override { return VK_SUCCESS; }
+        void     onResize(size_t width, size_t height) override;
+        bool     isPresentable() const override { return false; }
+        bool     isReadable() const override { return true; }
+
+        size_t             getImageViewSize()           const override { return m_Images.size(); }
+        const VkImage&     getImage(uint32_t index)     const override { return m_Images[index]->getImage(); }
+        const VkImageView& getImageView(uint32_t index) const override { return m_Images[index]->getImageView(); }
+        const VkFormat&    getImageFormat()             const override { return m_Format; }
+        const VkExtent2D&  getExtent()                  const override { return m_Extent; }
+        uint32_t           getCurrentImage()            const override { return m_CurrentImage; }
+        VkImageLayout      getFinalLayout()             const override { return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; }
+
+    private:
+        void createImages();
+
+    private:
+        // RGBA so read back pixels can be written out as they are
+        VkFormat            m_Format = VK_FORMAT_R8G8B8A8_UNORM;
+        VkExtent2D          m_Extent;
+        std::vector<Image*> m_Images;
+        uint32_t            m_ImageCount;
+        uint32_t            m_CurrentImage = 0;
+    };
+}
+
+#endif // YARE_OFFSCREEN_TARGET_H
@@ -1,15 +1,28 @@
 #include "Graphics/Vulkan/Pipeline.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
+#include "Graphics/Vulkan/RenderStatistics.h"
 #include "Utilities/Logger.h"
 
+#include <algorithm>
+
 namespace Yare::Graphics {
 
     Pipeline::Pipeline() {
     }
 
     Pipeline::~Pipeline() {
-        if (m_DescriptorSetLayout) {
-            vkDestroyDescriptorSetLayout(Devices::instance()->getDevice(), m_DescriptorSetLayout, nullptr);
+        // The compiler still references our state, let it finish first
+        if (m_PendingPipeline.valid()) {
+            m_GraphicsPipeline = m_PendingPipeline.get();
+        }
+        for (auto& [features, variant] : m_Variants) {
+            if (variant.pending.valid()) {
+                variant.pipeline = variant.pending.get();
+            }
+            if (variant.pipeline) {
+                vkDestroyPipeline(Devices::instance()->getDevice(), variant.pipeline, nullptr);
+            }
         }
         if (m_PipelineLayout) {
             vkDestroyPipelineLayout(Devices::instance()->getDevice(), m_PipelineLayout, nullptr);
@@ -17,44 +30,196 @@ namespace Yare::Graphics {
         if (m_GraphicsPipeline) {
             vkDestroyPipeline(Devices::instance()->getDevice(), m_GraphicsPipeline, nullptr);
         }
-        if (m_DescriptorPool) {
-            vkDestroyDescriptorPool(Devices::instance()->getDevice(), m_DescriptorPool, nullptr);
-        }
     }
 
     void Pipeline::init(PipelineInfo& pipelineInfo) {
         m_PipelineInfo = pipelineInfo;
+        if (!m_PipelineInfo.shader) {
+            m_PipelineInfo.shader = std::make_shared<Shader>(pipelineInfo.shaderPath, pipelineInfo.shaderName);
+        }
+        m_PushDescriptors = pipelineInfo.pushDescriptors && Devices::instance()->isPushDescriptorSupported();
+        // The shader declares the interface, the renderer only overrides what SPIR-V can't express
+        resolveLayout();
         // A descriptor is a special opaque shader variable that shaders use to access buffer and image
         // resources in an indirect fashion. It can be thought of as a "pointer" to a resource.
-        // The layout is used to describe the content of a list of descriptor sets
+        // The layout is used to describe the content of a list of descriptor sets, pipelines with the
+        // same bindings share one
         createDescriptorSetLayout();
 
-        // Pipeline yay
-        createGraphicsPipeline();
+        createPipelineLayout();
 
-        // Descriptor sets can't be created directly, they must be allocated from a pool like command buffers. We create those here.
-        createDescriptorPool();
+        // Pipeline yay, compiled in the background
+        createGraphicsPipeline();
     }
 
     void Pipeline::setActive(const CommandBuffer& commandBuffer) {
         vkCmdBindPipeline(commandBuffer.getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline);
+        RenderStatistics::instance()->add(RenderCounter::PipelineBinds);
+    }
+
+    void Pipeline::setActive(const CommandBuffer& commandBuffer, uint32_t features) {
+        // Without declared features every mask specializes to the same pipeline
+        if (features == m_PipelineInfo.features || !m_PipelineInfo.shader || m_PipelineInfo.shader->getFeatures().empty()) {
+            setActive(commandBuffer);
+            return;
+        }
+
+        auto& variant = m_Variants[features];
+        if (!variant.pipeline && !variant.pending.valid()) {
+            variant.pending = VulkanContext::getContext()->getPipelineCompiler()->submit([this, features] {
+                return compileGraphicsPipeline(features);
+            });
+        }
+        if (variant.pending.valid() &&
+            variant.pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            variant.pipeline = variant.pending.get();
+            if (!variant.pipeline) {
+                YZ_CRITICAL("Vulkan failed to create a graphics pipeline variant.");
+            }
+        }
+
+        if (variant.pipeline) {
+            vkCmdBindPipeline(commandBuffer.getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, variant.pipeline);
+            RenderStatistics::instance()->add(RenderCounter::PipelineBinds);
+        } else {
+            setActive(commandBuffer);
+        }
+    }
+
+    uint32_t Pipeline::getFeatureMask(const std::vector<std::string>& featureNames) const {
+        // The shader is only released once compiled when it declares no features
+        return m_PipelineInfo.shader ? m_PipelineInfo.shader->getFeatureMask(featureNames) : 0;
+    }
+
+    bool Pipeline::isCompiled() {
+        if (m_PendingPipeline.valid() &&
+            m_PendingPipeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            m_GraphicsPipeline = m_PendingPipeline.get();
+            if (!m_GraphicsPipeline) {
+                YZ_CRITICAL("Vulkan failed to create a graphics pipeline.");
+            }
+            // The modules are baked into the pipeline now, unless other variants may still be compiled from them
+            if (m_PipelineInfo.shader->getFeatures().empty()) {
+                m_PipelineInfo.shader.reset();
+            }
+        }
+        return m_GraphicsPipeline != VK_NULL_HANDLE;
+    }
+
+    bool Pipeline::isReady() {
+        return isCompiled();
+    }
+
+    void Pipeline::resolveLayout() {
+        const auto& layout = m_PipelineInfo.shader->getLayout();
+        const auto& shaderName = m_PipelineInfo.shader->getName();
+
+        // Reflected bindings carry the exact stages that use them, so equal interfaces hash to the
+        // same cached layout no matter how the renderer spelled them out
+        auto bindings = layout.bindings;
+        for (const auto& declared : m_PipelineInfo.layoutBindings) {
+            auto reflected = std::find_if(bindings.begin(), bindings.end(), [&](const VkDescriptorSetLayoutBinding& binding) {
+                return binding.binding == declared.binding;
+            });
+            if (reflected == bindings.end()) {
+                YZ_WARN("Binding " + STR(declared.binding) + " is not used by shader '" + shaderName + "'");
+                bindings.push_back(declared);
+                continue;
+            }
+
+            // Dynamic offsets are a property of the binding, not of the shader
+            bool compatible = declared.descriptorType == reflected->descriptorType ||
+                    (declared.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC &&
+                     reflected->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) ||
+                    (declared.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC &&
+                     reflected->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+            if (!compatible) {
+                YZ_WARN("Binding " + STR(declared.binding) + " of shader '" + shaderName + "' has descriptor type " +
+                        STR(reflected->descriptorType) + ", the pipeline declares " + STR(declared.descriptorType));
+            }
+            if (declared.descriptorCount < reflected->descriptorCount) {
+                YZ_WARN("Binding " + STR(declared.binding) + " of shader '" + shaderName + "' is an array of " +
+                        STR(reflected->descriptorCount) + ", the pipeline declares " + STR(declared.descriptorCount));
+            }
+            reflected->descriptorType = declared.descriptorType;
+            reflected->descriptorCount = declared.descriptorCount;
+            reflected->pImmutableSamplers = declared.pImmutableSamplers;
+        }
+        m_PipelineInfo.layoutBindings = bindings;
+
+        if (m_PipelineInfo.pushConstants.size == 0) {
+            m_PipelineInfo.pushConstants = layout.pushConstants;
+        } else if (m_PipelineInfo.pushConstants.offset + m_PipelineInfo.pushConstants.size < layout.pushConstants.size ||
+                   (m_PipelineInfo.pushConstants.stageFlags & layout.pushConstants.stageFlags) != layout.pushConstants.stageFlags) {
+            YZ_WARN("The push constant range of the pipeline does not cover the " + STR(layout.pushConstants.size) +
+                    " bytes shader '" + shaderName + "' reads");
+        }
+
+        for (const auto& input : layout.vertexInputs) {
+            auto attribute = std::find_if(m_PipelineInfo.vertexInputAttributes.begin(), m_PipelineInfo.vertexInputAttributes.end(),
+                                          [&](const VkVertexInputAttributeDescription& attribute) {
+                                              return attribute.location == input.location;
+                                          });
+            if (attribute == m_PipelineInfo.vertexInputAttributes.end()) {
+                YZ_WARN("Vertex input location " + STR(input.location) + " of shader '" + shaderName + "' is not fed by the pipeline");
+            }
+        }
     }
 
     void Pipeline::createDescriptorSetLayout() {
+        VkDescriptorSetLayoutCreateFlags flags = m_PushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
+        m_DescriptorSetLayout = VulkanContext::getContext()->getDescriptorLayoutCache()->getLayout(
+                m_PipelineInfo.layoutBindings, flags);
+    }
 
-        VkDescriptorSetLayoutCreateInfo layoutInfo = {};
-        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = static_cast<uint32_t>(m_PipelineInfo.layoutBindings.size());
-        layoutInfo.pBindings = m_PipelineInfo.layoutBindings.data();
+    void Pipeline::createPipelineLayout() {
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
+        pipelineLayoutInfo.pPushConstantRanges = &m_PipelineInfo.pushConstants;
+        pipelineLayoutInfo.pushConstantRangeCount = m_PipelineInfo.pushConstants.size > 0 ? 1 : 0;
 
-        auto res = vkCreateDescriptorSetLayout(Devices::instance()->getDevice(),
-                                               &layoutInfo, nullptr, &m_DescriptorSetLayout);
+        auto res = vkCreatePipelineLayout(Devices::instance()->getDevice(), &pipelineLayoutInfo,
+                                          nullptr, &m_PipelineLayout);
         if (res != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan was unable to create a descriptor set layout.");
+            YZ_CRITICAL("Vulkan Pipeline Layout was unable to be created.");
         }
     }
 
     void Pipeline::createGraphicsPipeline() {
+        m_PendingPipeline = VulkanContext::getContext()->getPipelineCompiler()->submit([this] {
+            return compileGraphicsPipeline(m_PipelineInfo.features);
+        });
+    }
+
+    VkPipeline Pipeline::compileGraphicsPipeline(uint32_t features) const {
+        // Every declared feature is a boolean specialization constant, the driver folds the disabled
+        // branches away so no variant pays for features it does not use
+        const auto& shaderFeatures = m_PipelineInfo.shader->getFeatures();
+        std::vector<VkBool32> specializationData;
+        std::vector<VkSpecializationMapEntry> specializationEntries;
+        for (size_t i = 0; i < shaderFeatures.size(); i++) {
+            specializationData.push_back((features & (1u << i)) ? VK_TRUE : VK_FALSE);
+            specializationEntries.push_back({shaderFeatures[i].constantId,
+                                             static_cast<uint32_t>(i * sizeof(VkBool32)), sizeof(VkBool32)});
+        }
+
+        VkSpecializationInfo specializationInfo = {};
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(specializationEntries.size());
+        specializationInfo.pMapEntries = specializationEntries.data();
+        specializationInfo.dataSize = specializationData.size() * sizeof(VkBool32);
+        specializationInfo.pData = specializationData.data();
+
+        // The shader's stages are shared between variants, each compile specializes its own copy
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages(
+                m_PipelineInfo.shader->getShaderStages(),
+                m_PipelineInfo.shader->getShaderStages() + m_PipelineInfo.shader->getStageCount());
+        if (!shaderFeatures.empty()) {
+            for (auto& stage : shaderStages) {
+                stage.pSpecializationInfo = &specializationInfo;
+            }
+        }
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -69,24 +234,11 @@ namespace Yare::Graphics {
         inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-        VkViewport viewport = {};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float)m_PipelineInfo.width;
-        viewport.height = (float)m_PipelineInfo.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        VkRect2D scissor = {};
-        scissor.offset = { 0,0 };
-        scissor.extent = { (uint32_t)m_PipelineInfo.width, (uint32_t)m_PipelineInfo.height };
-
+        // Viewport and scissor are set when the render pass begins, so the pipeline does not depend on the window size
         VkPipelineViewportStateCreateInfo viewportState = {};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
         viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
 
         VkPipelineRasterizationStateCreateInfo rasterizer = {};
         rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -155,24 +307,10 @@ namespace Yare::Graphics {
         colorBlending.blendConstants[2] = 0.0f;
         colorBlending.blendConstants[3] = 0.0f;
 
-
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 1;
-        pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
-        pipelineLayoutInfo.pPushConstantRanges = &m_PipelineInfo.pushConstants;
-        pipelineLayoutInfo.pushConstantRangeCount = 1;
-
-        auto res = vkCreatePipelineLayout(Devices::instance()->getDevice(), &pipelineLayoutInfo,
-                                          nullptr, &m_PipelineLayout);
-        if (res != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan Pipeline Layout was unable to be created.");
-        }
-
         VkGraphicsPipelineCreateInfo pipelineCreateInfo = {};
         pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineCreateInfo.stageCount = m_PipelineInfo.shader->getStageCount();
-        pipelineCreateInfo.pStages = m_PipelineInfo.shader->getShaderStages();
+        pipelineCreateInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
+        pipelineCreateInfo.pStages = shaderStages.data();
         pipelineCreateInfo.pVertexInputState = &vertexInputInfo;
         pipelineCreateInfo.pInputAssemblyState = &inputAssembly;
         pipelineCreateInfo.pViewportState = &viewportState;
@@ -181,47 +319,26 @@ namespace Yare::Graphics {
         pipelineCreateInfo.pDepthStencilState = &depthStencil;
         pipelineCreateInfo.pColorBlendState = &colorBlending;
 
+        std::vector<VkDynamicState> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        dynamicStates.insert(dynamicStates.end(), m_PipelineInfo.dynamicStates.begin(), m_PipelineInfo.dynamicStates.end());
+
         VkPipelineDynamicStateCreateInfo pipelineDynamicStateCreateInfo = {};
-        if (!m_PipelineInfo.dynamicStates.empty()) {
-            pipelineDynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-            pipelineDynamicStateCreateInfo.pDynamicStates = m_PipelineInfo.dynamicStates.data();
-            pipelineDynamicStateCreateInfo.dynamicStateCount = (uint32_t)m_PipelineInfo.dynamicStates.size();
-            pipelineDynamicStateCreateInfo.flags = 0;
-            pipelineCreateInfo.pDynamicState = &pipelineDynamicStateCreateInfo;
-        }
+        pipelineDynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        pipelineDynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
+        pipelineDynamicStateCreateInfo.dynamicStateCount = (uint32_t)dynamicStates.size();
+        pipelineDynamicStateCreateInfo.flags = 0;
+        pipelineCreateInfo.pDynamicState = &pipelineDynamicStateCreateInfo;
 
         pipelineCreateInfo.layout = m_PipelineLayout;
         pipelineCreateInfo.renderPass = m_PipelineInfo.renderpass->getRenderPass();
         pipelineCreateInfo.subpass = 0;
         pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-        res = vkCreateGraphicsPipelines(Devices::instance()->getDevice(), VK_NULL_HANDLE, 1,
-                                        &pipelineCreateInfo, nullptr, &m_GraphicsPipeline);
-        if (res != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan failed to create a graphics pipeline.");
-        }
-    }
-
-    void Pipeline::createDescriptorPool() {
-
-        std::vector<VkDescriptorPoolSize> poolSizes(m_PipelineInfo.layoutBindings.size());
-
-        int bindingIndex = 0;
-        for (auto binding : m_PipelineInfo.layoutBindings) {
-            poolSizes[bindingIndex].type = binding.descriptorType;
-            poolSizes[bindingIndex].descriptorCount = binding.descriptorCount;
-            bindingIndex++;
-        }
-
-        VkDescriptorPoolCreateInfo poolInfo = {};
-        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-        poolInfo.pPoolSizes = poolSizes.data();
-        poolInfo.maxSets = m_PipelineInfo.maxObjects;
-
-        auto res = vkCreateDescriptorPool(Devices::instance()->getDevice(), &poolInfo, nullptr, &m_DescriptorPool);
-        if (res != VK_SUCCESS) {
-            YZ_CRITICAL("Vulkan creation of descriptor pool failed.");
-        }
+        // The cache is internally synchronized, any number of compiler threads may use it at once
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        auto pipelineCache = VulkanContext::getContext()->getPipelineCache()->getPipelineCache();
+        auto res = vkCreateGraphicsPipelines(Devices::instance()->getDevice(), pipelineCache, 1,
+                                             &pipelineCreateInfo, nullptr, &pipeline);
+        return res == VK_SUCCESS ? pipeline : VK_NULL_HANDLE;
     }
 }
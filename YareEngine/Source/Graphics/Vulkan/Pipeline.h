@@ -8,25 +8,42 @@
 #include "Graphics/Vulkan/Shader.h"
 #include "Core/DataStructures.h"
 
+#include <future>
+#include <memory>
+#include <unordered_map>
+
 #define MAX_NUM_TEXTURES 256
 
 namespace Yare::Graphics {
 
+    class Pipeline;
+
     struct PipelineInfo {
-        Shader* shader;
+        // Directory and manifest of the shader, it is only loaded when no matching pipeline exists yet
+        std::string shaderPath;
+        std::string shaderName;
+        // Loaded by init, shared so the modules outlive the call while the pipeline compiles in the background
+        std::shared_ptr<Shader> shader;
         RenderPass* renderpass;
         bool depthWriteEnable;
         bool depthTestEnable;
         VkCullModeFlags cullMode;
+        // Descriptor bindings and push constants are reflected from the shader, list a binding here
+        // only to change what SPIR-V can't express: dynamic buffers, larger arrays or immutable samplers.
+        // Immutable samplers only have to stay alive until init returns.
         std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
         std::vector<VkVertexInputAttributeDescription> vertexInputAttributes;
         VkVertexInputBindingDescription bindingDescription;
+        // Viewport and scissor are always dynamic, list any additional dynamic state here
         std::vector<VkDynamicState> dynamicStates;
-        uint32_t maxObjects;
-        size_t width;
-        size_t height;
-        VkPushConstantRange pushConstants;
+        // Left zeroed to use the range the shader declares
+        VkPushConstantRange pushConstants = {0, 0, 0};
         bool colorBlendingEnabled = false;
+        // Descriptors are pushed into the command buffer instead of bound from a set, where the device
+        // supports it. Dynamic buffers can't be pushed.
+        bool pushDescriptors = false;
+        // Feature mask of the shader the base variant is specialized with, see Shader::getFeatureMask
+        uint32_t features = 0;
     };
 
     class Pipeline {
@@ -36,24 +53,49 @@ namespace Yare::Graphics {
         ~Pipeline();
         void init(PipelineInfo& pipelineInfo);
         void setActive(const CommandBuffer& commandBuffer);
+        // Binds the variant specialized for the feature mask. Each variant is compiled once, on first
+        // use, and the base variant is bound in its place until it is ready.
+        void setActive(const CommandBuffer& commandBuffer, uint32_t features);
+
+        // True once this pipeline has been compiled
+        bool isCompiled();
+        // True once the pipeline can be bound, renderers skip drawing until then
+        bool isReady();
+        bool usesPushDescriptors() const { return m_PushDescriptors; }
 
-        const VkDescriptorPool&      getDescriptorPool()       const { return m_DescriptorPool; }
         const VkDescriptorSetLayout& getDescriptorSetLayout()  const { return m_DescriptorSetLayout; }
         const VkPipelineLayout&      getPipelineLayout()       const { return m_PipelineLayout; }
         const VkPipeline&            getPipeline()             const { return m_GraphicsPipeline; }
+        // Stages the renderer passes to vkCmdPushConstants
+        const VkPushConstantRange&   getPushConstantRange()    const { return m_PipelineInfo.pushConstants; }
+        // See Shader::getFeatureMask, 0 for a shader without declared features
+        uint32_t getFeatureMask(const std::vector<std::string>& featureNames) const;
 
     private:
+        // Merges the reflected shader layout with the overrides of the pipeline info
+        void resolveLayout();
         void createDescriptorSetLayout();
+        void createPipelineLayout();
         void createGraphicsPipeline();
-        void createDescriptorPool();
+        // Runs on a compiler thread
+        VkPipeline compileGraphicsPipeline(uint32_t features) const;
 
     private:
         PipelineInfo m_PipelineInfo;
 
-        VkDescriptorPool      m_DescriptorPool        = VK_NULL_HANDLE;
+        // Owned by the context's layout cache
         VkDescriptorSetLayout m_DescriptorSetLayout   = VK_NULL_HANDLE;
         VkPipelineLayout      m_PipelineLayout        = VK_NULL_HANDLE;
         VkPipeline            m_GraphicsPipeline      = VK_NULL_HANDLE;
+        std::future<VkPipeline> m_PendingPipeline;
+
+        struct Variant {
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            std::future<VkPipeline> pending;
+        };
+        // Every variant other than the base one, by feature mask
+        std::unordered_map<uint32_t, Variant> m_Variants;
+        bool                  m_PushDescriptors       = false;
 
     };
 }
@@ -0,0 +1,114 @@
+#include "Graphics/Vulkan/PipelineCache.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#define PIPELINE_CACHE_MAGIC   0x43505659 // "YVPC"
+#define PIPELINE_CACHE_VERSION 1
+
+namespace Yare::Graphics {
+
+    PipelineCache::PipelineCache(const std::string& filePath)
+        : m_FilePath(filePath) {
+        std::vector<char> data;
+        m_Warm = load(data);
+
+        VkPipelineCacheCreateInfo cacheInfo = {};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cacheInfo.initialDataSize = m_Warm ? data.size() : 0;
+        cacheInfo.pInitialData = m_Warm ? data.data() : nullptr;
+
+        auto res = vkCreatePipelineCache(Devices::instance()->getDevice(), &cacheInfo, nullptr, &m_PipelineCache);
+        if (res != VK_SUCCESS && m_Warm) {
+            // The driver is free to reject data it does not like, fall back to an empty cache
+            YZ_WARN("Pipeline cache '" + m_FilePath + "' was rejected by the driver, starting cold.");
+            m_Warm = false;
+            cacheInfo.initialDataSize = 0;
+            cacheInfo.pInitialData = nullptr;
+            res = vkCreatePipelineCache(Devices::instance()->getDevice(), &cacheInfo, nullptr, &m_PipelineCache);
+        }
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to create a pipeline cache.");
+        }
+
+        YZ_INFO("Pipeline cache " + std::string(m_Warm ? "loaded " + STR(data.size()) + " bytes from '" + m_FilePath + "'"
+                                                       : "starting cold"));
+    }
+
+    PipelineCache::~PipelineCache() {
+        if (m_PipelineCache) {
+            save();
+            vkDestroyPipelineCache(Devices::instance()->getDevice(), m_PipelineCache, nullptr);
+        }
+    }
+
+    bool PipelineCache::save() {
+        size_t dataSize = 0;
+        auto device = Devices::instance()->getDevice();
+        if (vkGetPipelineCacheData(device, m_PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+            return false;
+        }
+
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(device, m_PipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+            YZ_WARN("Vulkan failed to read back the pipeline cache.");
+            return false;
+        }
+
+        std::ofstream file(m_FilePath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            YZ_WARN("Pipeline cache '" + m_FilePath + "' could not be opened for writing.");
+            return false;
+        }
+
+        FileHeader header = createHeader(dataSize);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(data.data(), static_cast<std::streamsize>(dataSize));
+        return file.good();
+    }
+
+    bool PipelineCache::load(std::vector<char>& data) {
+        std::ifstream file(m_FilePath, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        FileHeader header = {};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            YZ_WARN("Pipeline cache '" + m_FilePath + "' is truncated, ignoring it.");
+            return false;
+        }
+
+        // A cache from another GPU or driver is useless at best, so only accept an exact match
+        FileHeader expected = createHeader(header.dataSize);
+        if (std::memcmp(&header, &expected, sizeof(FileHeader)) != 0) {
+            YZ_WARN("Pipeline cache '" + m_FilePath + "' was built for a different device or driver, ignoring it.");
+            return false;
+        }
+
+        data.resize(static_cast<size_t>(header.dataSize));
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+            YZ_WARN("Pipeline cache '" + m_FilePath + "' is truncated, ignoring it.");
+            data.clear();
+            return false;
+        }
+        return true;
+    }
+
+    PipelineCache::FileHeader PipelineCache::createHeader(uint64_t dataSize) const {
+        const auto& properties = Devices::instance()->getGPUProperties();
+
+        FileHeader header = {};
+        header.magic = PIPELINE_CACHE_MAGIC;
+        header.version = PIPELINE_CACHE_VERSION;
+        header.vendorID = properties.vendorID;
+        header.deviceID = properties.deviceID;
+        header.driverVersion = properties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+        header.dataSize = dataSize;
+        return header;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef YARE_PIPELINE_CACHE_H
+#define YARE_PIPELINE_CACHE_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <string>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Shared VkPipelineCache that is seeded from disk at startup and written back on shutdown,
+    // so pipelines only pay for full shader compilation the first time they are built on a device.
+    class PipelineCache {
+    public:
+        PipelineCache(const std::string& filePath);
+        ~PipelineCache();
+
+        // Writes the current cache contents to disk, returns false if nothing could be written
+        bool save();
+
+        const VkPipelineCache& getPipelineCache() const { return m_PipelineCache; }
+        // True when the cache was seeded with valid data from a previous run
+        bool                   isWarm()           const { return m_Warm; }
+
+    private:
+        // Written in front of the driver's data, the driver only checks vendor, device and cache UUID
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            // Keeps the struct free of padding, the header is compared byte for byte
+            uint32_t reserved;
+            uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+            uint64_t dataSize;
+        };
+
+        bool load(std::vector<char>& data);
+        FileHeader createHeader(uint64_t dataSize) const;
+
+    private:
+        std::string     m_FilePath;
+        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+        bool            m_Warm = false;
+    };
+}
+
+#endif // YARE_PIPELINE_CACHE_H
@@ -0,0 +1,54 @@
+#include "Graphics/Vulkan/PipelineCompiler.h"
+#include "Utilities/Profiler.h"
+
+#include <algorithm>
+
+namespace Yare::Graphics {
+
+    PipelineCompiler::PipelineCompiler(uint32_t threadCount) {
+        for (uint32_t i = 0; i < std::max(threadCount, 1u); i++) {
+            m_Workers.emplace_back(&PipelineCompiler::workerLoop, this);
+        }
+    }
+
+    PipelineCompiler::~PipelineCompiler() {
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Running = false;
+        }
+        m_JobCondition.notify_all();
+        for (auto& worker : m_Workers) {
+            worker.join();
+        }
+    }
+
+    std::future<VkPipeline> PipelineCompiler::submit(std::function<VkPipeline()> job) {
+        std::packaged_task<VkPipeline()> task(std::move(job));
+        auto future = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Jobs.push_back(std::move(task));
+        }
+        m_JobCondition.notify_one();
+        return future;
+    }
+
+    void PipelineCompiler::workerLoop() {
+        YZ_PROFILE_THREAD("Pipeline compiler");
+        while (true) {
+            std::packaged_task<VkPipeline()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                m_JobCondition.wait(lock, [this] { return !m_Running || !m_Jobs.empty(); });
+                // Drain the queue before stopping, pipelines wait on their futures when destroyed
+                if (m_Jobs.empty()) {
+                    return;
+                }
+                task = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+            YZ_PROFILE_SCOPE("Compile pipeline");
+            task();
+        }
+    }
+}
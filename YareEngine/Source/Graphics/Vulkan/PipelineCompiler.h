@@ -0,0 +1,41 @@
+#ifndef YARE_PIPELINE_COMPILER_H
+#define YARE_PIPELINE_COMPILER_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Pool of worker threads that build pipelines in the background so that
+    // creating one never stalls the frame it was requested in.
+    class PipelineCompiler {
+    public:
+        PipelineCompiler(uint32_t threadCount);
+        ~PipelineCompiler();
+
+        // Queues a job that creates a pipeline, the future holds VK_NULL_HANDLE if it failed.
+        // Jobs run on a worker thread, they may log like any other thread.
+        std::future<VkPipeline> submit(std::function<VkPipeline()> job);
+
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    private:
+        void workerLoop();
+
+    private:
+        std::vector<std::thread>                     m_Workers;
+        bool                                         m_Running = true;
+        std::mutex                                   m_JobMutex;
+        std::condition_variable                      m_JobCondition;
+        std::deque<std::packaged_task<VkPipeline()>> m_Jobs;
+    };
+}
+
+#endif // YARE_PIPELINE_COMPILER_H
@@ -0,0 +1,108 @@
+#include "Graphics/Vulkan/PipelineRegistry.h"
+#include "Graphics/Vulkan/Context.h"
+
+#include <functional>
+
+namespace Yare::Graphics {
+
+    PipelineRegistry::PipelineRegistry() {
+    }
+
+    PipelineRegistry::~PipelineRegistry() {
+    }
+
+    std::shared_ptr<Pipeline> PipelineRegistry::getPipeline(PipelineInfo& pipelineInfo) {
+        m_RequestCount++;
+        auto key = createKey(pipelineInfo);
+
+        auto found = m_Pipelines.find(key);
+        if (found != m_Pipelines.end()) {
+            m_SharedCount++;
+            found->second.requests++;
+            return found->second.pipeline;
+        }
+
+        Entry entry;
+        entry.requests = 1;
+        entry.pipeline = std::make_shared<Pipeline>();
+        entry.pipeline->init(pipelineInfo);
+
+        auto pipeline = entry.pipeline;
+        m_Pipelines.emplace(std::move(key), std::move(entry));
+        return pipeline;
+    }
+
+    uint64_t PipelineRegistry::getRequestCount(const Pipeline* pipeline) const {
+        for (const auto& [key, entry] : m_Pipelines) {
+            if (entry.pipeline.get() == pipeline) {
+                return entry.requests;
+            }
+        }
+        return 0;
+    }
+
+    void PipelineRegistry::collect() {
+        auto& deletionQueue = VulkanContext::getContext()->getDeletionQueue();
+        for (auto iter = m_Pipelines.begin(); iter != m_Pipelines.end();) {
+            if (iter->second.pipeline.use_count() == 1) {
+                deletionQueue->push([pipeline = std::move(iter->second.pipeline)]() mutable {
+                    pipeline.reset();
+                });
+                iter = m_Pipelines.erase(iter);
+            } else {
+                iter++;
+            }
+        }
+    }
+
+    PipelineRegistry::PipelineKey PipelineRegistry::createKey(const PipelineInfo& pipelineInfo) const {
+        PipelineKey key;
+        key.shader = pipelineInfo.shaderPath + "/" + pipelineInfo.shaderName;
+
+        auto& state = key.state;
+        // Pipelines are only compatible with render passes like the one they were created for,
+        // which for the render passes of this engine means the same one
+        state.push_back((uint64_t)pipelineInfo.renderpass->getRenderPass());
+        state.push_back(pipelineInfo.depthWriteEnable | (pipelineInfo.depthTestEnable << 1) |
+                        (pipelineInfo.colorBlendingEnabled << 2) | (pipelineInfo.pushDescriptors << 3) |
+                        (static_cast<uint64_t>(pipelineInfo.cullMode) << 8) |
+                        (static_cast<uint64_t>(pipelineInfo.features) << 32));
+
+        state.push_back(pipelineInfo.bindingDescription.binding | (static_cast<uint64_t>(pipelineInfo.bindingDescription.stride) << 16) |
+                        (static_cast<uint64_t>(pipelineInfo.bindingDescription.inputRate) << 48));
+        state.push_back(pipelineInfo.vertexInputAttributes.size());
+        for (const auto& attribute : pipelineInfo.vertexInputAttributes) {
+            state.push_back(attribute.location | (static_cast<uint64_t>(attribute.binding) << 16) |
+                            (static_cast<uint64_t>(attribute.offset) << 32));
+            state.push_back(attribute.format);
+        }
+
+        state.push_back(pipelineInfo.dynamicStates.size());
+        for (auto dynamicState : pipelineInfo.dynamicStates) {
+            state.push_back(dynamicState);
+        }
+
+        state.push_back(pipelineInfo.pushConstants.stageFlags | (static_cast<uint64_t>(pipelineInfo.pushConstants.offset) << 32));
+        state.push_back(pipelineInfo.pushConstants.size);
+
+        state.push_back(pipelineInfo.layoutBindings.size());
+        for (const auto& binding : pipelineInfo.layoutBindings) {
+            state.push_back(binding.binding | (static_cast<uint64_t>(binding.descriptorType) << 32));
+            state.push_back(binding.descriptorCount | (static_cast<uint64_t>(binding.stageFlags) << 32));
+            if (binding.pImmutableSamplers) {
+                for (uint32_t i = 0; i < binding.descriptorCount; i++) {
+                    state.push_back((uint64_t)binding.pImmutableSamplers[i]);
+                }
+            }
+        }
+        return key;
+    }
+
+    size_t PipelineRegistry::PipelineKeyHash::operator()(const PipelineKey& key) const {
+        size_t hash = std::hash<std::string>()(key.shader);
+        for (auto value : key.state) {
+            hash ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
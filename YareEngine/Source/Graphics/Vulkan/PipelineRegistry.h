@@ -0,0 +1,64 @@
+#ifndef YARE_PIPELINE_REGISTRY_H
+#define YARE_PIPELINE_REGISTRY_H
+
+#include "Graphics/Vulkan/Pipeline.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // Hands out one pipeline per distinct pipeline state, so renderers and materials that ask for the
+    // same shader, render pass and fixed function state share a pipeline instead of compiling their own.
+    // A pipeline is retired once no caller holds it anymore.
+    class PipelineRegistry {
+    public:
+        PipelineRegistry();
+        ~PipelineRegistry();
+
+        // Shaders are matched by path and name, they are only loaded when no pipeline matches.
+        // Immutable samplers only have to stay alive until this returns.
+        std::shared_ptr<Pipeline> getPipeline(PipelineInfo& pipelineInfo);
+
+        // Hands the pipelines nobody holds to the deletion queue, called once per frame
+        void collect();
+
+        size_t   getPipelineCount() const { return m_Pipelines.size(); }
+        // Requests served by an existing pipeline, and every request since the registry was created
+        uint64_t getSharedCount()   const { return m_SharedCount; }
+        uint64_t getRequestCount()  const { return m_RequestCount; }
+        // How often the pipeline was handed out, 0 for a pipeline the registry doesn't hold
+        uint64_t getRequestCount(const Pipeline* pipeline) const;
+
+    private:
+        struct PipelineKey {
+            std::string shader;
+            // Every other field of the info, flattened
+            std::vector<uint64_t> state;
+
+            bool operator==(const PipelineKey& other) const {
+                return shader == other.shader && state == other.state;
+            }
+        };
+
+        struct PipelineKeyHash {
+            size_t operator()(const PipelineKey& key) const;
+        };
+
+        struct Entry {
+            std::shared_ptr<Pipeline> pipeline;
+            uint64_t requests = 0;
+        };
+
+        PipelineKey createKey(const PipelineInfo& pipelineInfo) const;
+
+    private:
+        std::unordered_map<PipelineKey, Entry, PipelineKeyHash> m_Pipelines;
+        uint64_t m_SharedCount = 0;
+        uint64_t m_RequestCount = 0;
+    };
+}
+
+#endif // YARE_PIPELINE_REGISTRY_H
@@ -0,0 +1,14 @@
+#ifndef YARE_PRESENT_MODE_H
+#define YARE_PRESENT_MODE_H
+
+namespace Yare::Graphics {
+
+    enum class PresentMode {
+        LowLatency = 0, // Immediate, paced by a CPU frame limiter
+        Smooth,         // FIFO, paced by vsync
+        Throughput,     // Mailbox with triple buffering
+        Count
+    };
+}
+
+#endif // YARE_PRESENT_MODE_H
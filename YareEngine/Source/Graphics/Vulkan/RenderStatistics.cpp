@@ -0,0 +1,54 @@
+#include "Graphics/Vulkan/RenderStatistics.h"
+#include "Utilities/Logger.h"
+
+namespace Yare::Graphics {
+
+    const char* getRenderCounterName(RenderCounter counter) {
+        switch (counter) {
+        case RenderCounter::DrawCalls:         return "Draw calls";
+        case RenderCounter::Instances:         return "Instances";
+        case RenderCounter::Triangles:         return "Triangles";
+        case RenderCounter::PipelineBinds:     return "Pipeline binds";
+        case RenderCounter::DescriptorBinds:   return "Descriptor binds";
+        case RenderCounter::VertexBufferBinds: return "Vertex buffer binds";
+        case RenderCounter::IndexBufferBinds:  return "Index buffer binds";
+        case RenderCounter::BufferMaps:        return "Buffer maps";
+        case RenderCounter::BytesUploaded:     return "Bytes uploaded";
+        default:                               return "Unknown";
+        }
+    }
+
+    void RenderStatistics::beginFrame() {
+        RenderCounters counters;
+        for (int i = 0; i < static_cast<int>(RenderCounter::Count); i++) {
+            counters.values[i] = m_Current[i].exchange(0, std::memory_order_relaxed);
+        }
+        // Everything before the first frame was loading, not rendering
+        if (m_FrameCount++ == 0) {
+            return;
+        }
+        m_LastFrame = counters;
+
+        if (m_CsvLog.is_open()) {
+            m_CsvLog << m_FrameCount - 2;
+            for (auto value : counters.values) {
+                m_CsvLog << "," << value;
+            }
+            m_CsvLog << "\n";
+        }
+    }
+
+    bool RenderStatistics::openCsvLog(const std::string& filePath) {
+        m_CsvLog.open(filePath);
+        if (!m_CsvLog) {
+            YZ_WARN("Could not open " + filePath + " for the render statistics");
+            return false;
+        }
+        m_CsvLog << "frame";
+        for (int i = 0; i < static_cast<int>(RenderCounter::Count); i++) {
+            m_CsvLog << "," << getRenderCounterName(static_cast<RenderCounter>(i));
+        }
+        m_CsvLog << "\n";
+        return true;
+    }
+}
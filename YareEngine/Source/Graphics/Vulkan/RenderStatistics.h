@@ -0,0 +1,68 @@
+#ifndef YARE_RENDER_STATISTICS_H
+#define YARE_RENDER_STATISTICS_H
+
+#include "Utilities/T_Singleton.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace Yare::Graphics {
+
+    enum class RenderCounter {
+        DrawCalls = 0,
+        Instances,
+        Triangles,
+        PipelineBinds,
+        DescriptorBinds,    // Descriptor set binds and push descriptor updates
+        VertexBufferBinds,
+        IndexBufferBinds,
+        BufferMaps,
+        BytesUploaded,      // Copied into buffers by the CPU, including staging buffers
+        Count
+    };
+
+    const char* getRenderCounterName(RenderCounter counter);
+
+    struct RenderCounters {
+        uint64_t values[static_cast<int>(RenderCounter::Count)] = {};
+
+        uint64_t operator[](RenderCounter counter) const { return values[static_cast<int>(counter)]; }
+    };
+
+    // Counts the work each frame records. Uploads may come from the streaming workers, they count
+    // towards whichever frame is being recorded at the time.
+    class RenderStatistics : public Utilities::T_Singleton<RenderStatistics> {
+    public:
+        RenderStatistics() {}
+
+        void add(RenderCounter counter, uint64_t value = 1) {
+            m_Current[static_cast<int>(counter)].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        // Triangle lists only, which is all the renderers draw
+        void addDraw(uint32_t indexCount, uint32_t instanceCount) {
+            add(RenderCounter::DrawCalls);
+            add(RenderCounter::Instances, instanceCount);
+            add(RenderCounter::Triangles, static_cast<uint64_t>(indexCount / 3) * instanceCount);
+        }
+
+        // Ends the previous frame's counts and starts counting from 0
+        void beginFrame();
+
+        // Appends every frame's counters to a CSV file, one column per counter
+        bool openCsvLog(const std::string& filePath);
+
+        const RenderCounters& getLastFrame() const { return m_LastFrame; }
+        uint64_t              getFrameCount() const { return m_FrameCount; }
+
+    private:
+        std::atomic<uint64_t> m_Current[static_cast<int>(RenderCounter::Count)] = {};
+        RenderCounters        m_LastFrame;
+        uint64_t              m_FrameCount = 0;
+        std::ofstream         m_CsvLog;
+    };
+}
+
+#endif // YARE_RENDER_STATISTICS_H
@@ -0,0 +1,42 @@
+#ifndef YARE_RENDER_TARGET_H
+#define YARE_RENDER_TARGET_H
+
+#include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/PresentMode.h"
+
+#include <cstddef>
+
+namespace Yare::Graphics {
+
+    // The images a frame is rendered into, either a swapchain presenting to a window or
+    // offscreen images that are only ever read back
+    class RenderTarget {
+    public:
+        virtual ~RenderTarget() = default;
+
+        // Makes the next image current, presentable targets signal the semaphore once it may be rendered to
+        virtual VkResult acquireNextImage(VkSemaphore signalSemaphore) = 0;
+        // Presentable targets wait for the semaphore before presenting the current image
+        virtual VkResult present(VkSemaphore waitSemaphore) = 0;
+        virtual void     onResize(size_t width, size_t height) = 0;
+        // Presentable targets are recreated with these on the next onResize
+        virtual void     setPresentMode(PresentMode mode, uint32_t imageCount) {}
+        // True when the present mode or image count the target was created with no longer match
+        virtual bool     isOutdated() const { return false; }
+        // False if acquire and present neither signal nor wait, the frame is then submitted without them
+        virtual bool     isPresentable() const = 0;
+        // True if the images can be copied from, which swapchains do not have to support
+        virtual bool     isReadable() const = 0;
+
+        virtual size_t             getImageViewSize()           const = 0;
+        virtual const VkImage&     getImage(uint32_t index)     const = 0;
+        virtual const VkImageView& getImageView(uint32_t index) const = 0;
+        virtual const VkFormat&    getImageFormat()             const = 0;
+        virtual const VkExtent2D&  getExtent()                  const = 0;
+        virtual uint32_t           getCurrentImage()            const = 0;
+        // Layout the render pass leaves the images in
+        virtual VkImageLayout      getFinalLayout()             const = 0;
+    };
+}
+
+#endif // YARE_RENDER_TARGET_H
@@ -11,6 +11,8 @@ namespace Yare::Graphics {
     struct RenderPassInfo {
         VkFormat imageFormat;
         VkExtent2D extent;
+        // Layout of the color attachment once the pass ends
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     };
 
     class RenderPass {
@@ -21,6 +23,9 @@ namespace Yare::Graphics {
         void beginRenderPass(const CommandBuffer* commandBuffer, const Framebuffer* frameBuffer);
         void endRenderPass(const CommandBuffer* commandBuffer);
 
+        // The render pass itself does not depend on the size of its attachments, only the render area does
+        void setExtent(VkExtent2D extent) { m_Info.extent = extent; }
+
         const VkRenderPass& getRenderPass() const { return m_RenderPass; }
     private:
         void init();
@@ -0,0 +1,54 @@
+#include "Graphics/Vulkan/SamplerCache.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+namespace Yare::Graphics {
+
+    SamplerCache::SamplerCache() {
+    }
+
+    SamplerCache::~SamplerCache() {
+        for (auto& [samplerInfo, sampler] : m_Samplers) {
+            vkDestroySampler(Devices::instance()->getDevice(), sampler, nullptr);
+        }
+    }
+
+    VkSampler SamplerCache::getSampler(const SamplerInfo& samplerInfo) {
+        auto found = m_Samplers.find(samplerInfo);
+        if (found != m_Samplers.end()) {
+            return found->second;
+        }
+
+        auto filter = samplerInfo.filter;
+        auto mode = samplerInfo.addressMode;
+
+        VkSamplerCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        createInfo.magFilter = filter;
+        createInfo.minFilter = filter;
+        createInfo.addressModeU = mode;
+        createInfo.addressModeV = mode;
+        createInfo.addressModeW = mode;
+        // Nearest filtering is used for lookup tables, which must not be blended between texels or mips
+        createInfo.anisotropyEnable = filter == VK_FILTER_LINEAR ? VK_TRUE : VK_FALSE;
+        createInfo.maxAnisotropy = 16;
+        createInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_WHITE;
+        createInfo.unnormalizedCoordinates = VK_FALSE;
+        createInfo.compareEnable = VK_FALSE;
+        createInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+        createInfo.mipmapMode = filter == VK_FILTER_LINEAR ? VK_SAMPLER_MIPMAP_MODE_LINEAR
+                                                           : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        createInfo.mipLodBias = 0.0f;
+        createInfo.minLod = 0.0f;
+        // The image view limits the mips, so one sampler serves images with any number of them
+        createInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+        VkSampler sampler;
+        if (vkCreateSampler(Devices::instance()->getDevice(), &createInfo, nullptr, &sampler) != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to create a sampler.");
+        }
+
+        m_Samplers.emplace(samplerInfo, sampler);
+        return sampler;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef YARE_SAMPLER_CACHE_H
+#define YARE_SAMPLER_CACHE_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <unordered_map>
+
+namespace Yare::Graphics {
+
+    // The sampler state that differs between images, everything else is shared by every sampler
+    struct SamplerInfo {
+        VkFilter filter = VK_FILTER_LINEAR;
+        VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+
+        bool operator==(const SamplerInfo& other) const {
+            return filter == other.filter && addressMode == other.addressMode;
+        }
+    };
+
+    // Hands out one sampler per distinct sampler state. Samplers do not depend on the image they
+    // sample, so images share them instead of each counting against maxSamplerAllocationCount.
+    // The samplers live as long as the cache, which also makes them usable as immutable samplers.
+    class SamplerCache {
+    public:
+        SamplerCache();
+        ~SamplerCache();
+
+        VkSampler getSampler(const SamplerInfo& samplerInfo);
+
+        size_t getSamplerCount() const { return m_Samplers.size(); }
+
+    private:
+        struct SamplerInfoHash {
+            size_t operator()(const SamplerInfo& samplerInfo) const {
+                return (static_cast<size_t>(samplerInfo.filter) << 8) ^ static_cast<size_t>(samplerInfo.addressMode);
+            }
+        };
+
+    private:
+        std::unordered_map<SamplerInfo, VkSampler, SamplerInfoHash> m_Samplers;
+    };
+}
+
+#endif // YARE_SAMPLER_CACHE_H
@@ -3,6 +3,7 @@
 #include "Graphics/Vulkan/Utilities.h"
 #include "Utilities/IOHelper.h"
 #include "Utilities/Logger.h"
+#include <algorithm>
 #include <map>
 
 namespace Yare::Graphics {
@@ -30,6 +31,19 @@ namespace Yare::Graphics {
         }
     }
 
+    uint32_t Shader::getFeatureMask(const std::vector<std::string>& featureNames) const {
+        uint32_t mask = 0;
+        for (const auto& featureName : featureNames) {
+            auto found = std::find_if(m_Features.begin(), m_Features.end(),
+                                      [&](const ShaderFeature& feature) { return feature.name == featureName; });
+            if (found == m_Features.end()) {
+                YZ_CRITICAL("Shader '" + m_ShaderName + "' does not declare the feature " + featureName);
+            }
+            mask |= 1u << (found - m_Features.begin());
+        }
+        return mask;
+    }
+
     void Shader::readShaderFiles() {
         m_StageCount = 0;
         uint32_t currentShaderStage = 0;
@@ -38,6 +52,22 @@ namespace Yare::Graphics {
 
         for (auto iter = m_ShaderSource.begin(); iter < m_ShaderSource.end(); iter++) {
             std::string current_line = *iter;
+            // //FEATURE:NAME followed by the specialization constant id it toggles
+            if (begins_with(current_line, "//FEATURE:")) {
+                auto location = "Line " + std::to_string(iter - m_ShaderSource.begin() + 1) + " in file '" + m_ShaderName + "'";
+                if (m_Features.size() == 32) {
+                    YZ_CRITICAL(location + " declares more than 32 features, a feature mask has one bit per feature");
+                }
+                const auto& idLine = std::next(iter) == m_ShaderSource.end() ? std::string() : *std::next(iter);
+                if (idLine.empty() || idLine.find_first_not_of("0123456789 \t\r") != std::string::npos ||
+                        idLine.find_first_of("0123456789") == std::string::npos) {
+                    YZ_CRITICAL(location + " declares a feature without a constant id on the next line");
+                }
+                auto name = current_line.substr(std::string("//FEATURE:").size());
+                name.erase(name.find_last_not_of(" \t\r") + 1);
+                m_Features.push_back({name, static_cast<uint32_t>(std::stoul(idLine))});
+                continue;
+            }
             if (begins_with(current_line, "//SHADER:")) {
                 if (current_line.find("VERTEX") != std::string::npos) {
                     shaderFiles.insert(std::pair<ShaderType, std::string>(ShaderType::Vertex, *(std::next(iter))));
@@ -77,11 +107,19 @@ namespace Yare::Graphics {
         }
 
         m_ShaderStages = new VkPipelineShaderStageCreateInfo[m_StageCount]();
+        std::vector<uint32_t> specIds;
 
         for (auto file : shaderFiles) {
             m_ShaderType.push_back(file.first);
             auto rawShader = VkUtil::readShaderFile(m_FilePath + "//" + file.second);
 
+            ShaderReflection reflection(rawShader);
+            if (!reflection.isValid()) {
+                YZ_CRITICAL("Shader '" + file.second + "' could not be reflected: " + reflection.getError());
+            }
+            reflection.merge(static_cast<VkShaderStageFlagBits>(file.first), m_Layout);
+            specIds.insert(specIds.end(), reflection.getSpecIds().begin(), reflection.getSpecIds().end());
+
             VkShaderModuleCreateInfo createInfo = {};
             createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
             createInfo.codeSize = rawShader.size();
@@ -99,5 +137,13 @@ namespace Yare::Graphics {
 
             currentShaderStage++;
         }
+
+        // A feature whose constant no stage declares would silently specialize nothing, e.g. with stale SPIR-V
+        for (const auto& feature : m_Features) {
+            if (std::find(specIds.begin(), specIds.end(), feature.constantId) == specIds.end()) {
+                YZ_CRITICAL("Shader '" + m_ShaderName + "' declares the feature " + feature.name + " with constant id " +
+                            std::to_string(feature.constantId) + ", which none of its stages declares");
+            }
+        }
     }
 }
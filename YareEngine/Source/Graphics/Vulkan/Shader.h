@@ -2,6 +2,7 @@
 #define YARE_SHADER_H
 
 #include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/ShaderReflection.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -17,6 +18,13 @@ namespace Yare::Graphics {
                            Unknown = 0
     };
 
+    // A toggle declared in the .shader manifest, it is fed to every stage as the boolean
+    // specialization constant with the given id
+    struct ShaderFeature {
+        std::string name;
+        uint32_t constantId;
+    };
+
     class Shader {
     public:
         Shader(const std::string& filePath, const std::string& shaderName);
@@ -26,6 +34,14 @@ namespace Yare::Graphics {
         VkPipelineShaderStageCreateInfo* getShaderStages() const { return m_ShaderStages; }
         void unloadModules();
 
+        // Bit i of a feature mask enables getFeatures()[i]
+        const std::vector<ShaderFeature>& getFeatures() const { return m_Features; }
+        uint32_t getFeatureMask(const std::vector<std::string>& featureNames) const;
+
+        // Resources of all stages, reflected from the SPIR-V
+        const ShaderLayout& getLayout() const { return m_Layout; }
+        const std::string& getName() const { return m_ShaderName; }
+        const std::string& getFilePath() const { return m_FilePath; }
 
     private:
         void readShaderFiles();
@@ -36,6 +52,8 @@ namespace Yare::Graphics {
         std::vector<std::string> m_ShaderSource;
         uint32_t m_StageCount;
         std::vector<ShaderType> m_ShaderType;
+        std::vector<ShaderFeature> m_Features;
+        ShaderLayout m_Layout;
     };
 }
 
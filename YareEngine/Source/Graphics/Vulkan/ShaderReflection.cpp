@@ -0,0 +1,353 @@
+#include "Graphics/Vulkan/ShaderReflection.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Yare::Graphics {
+
+    // The few parts of the SPIR-V specification we need
+    namespace {
+        const uint32_t SpirvMagic = 0x07230203;
+
+        enum Op : uint32_t {
+            OpDecorate = 71, OpMemberDecorate = 72,
+            OpTypeVoid = 19, OpTypeBool = 20, OpTypeInt = 21, OpTypeFloat = 22, OpTypeVector = 23,
+            OpTypeMatrix = 24, OpTypeImage = 25, OpTypeSampler = 26, OpTypeSampledImage = 27,
+            OpTypeArray = 28, OpTypeRuntimeArray = 29, OpTypeStruct = 30, OpTypePointer = 32,
+            OpConstant = 43, OpSpecConstant = 50, OpVariable = 59
+        };
+
+        enum Decoration : uint32_t {
+            SpecId = 1, Block = 2, BufferBlock = 3, RowMajor = 4, ColMajor = 5, ArrayStride = 6, MatrixStride = 7, BuiltIn = 11,
+            Location = 30, Binding = 33, DescriptorSet = 34, Offset = 35
+        };
+
+        enum StorageClass : uint32_t {
+            UniformConstant = 0, Input = 1, Uniform = 2, PushConstant = 9, StorageBuffer = 12
+        };
+
+        const uint32_t DimBuffer = 5;
+        const uint32_t DimSubpassData = 6;
+    }
+
+    ShaderReflection::ShaderReflection(const std::vector<char>& code) {
+        if (code.size() < 5 * sizeof(uint32_t) || code.size() % sizeof(uint32_t) != 0) {
+            fail("the code is not a whole number of SPIR-V words");
+            return;
+        }
+        // The file buffer carries no alignment guarantee
+        std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+        std::memcpy(words.data(), code.data(), code.size());
+        parse(words.data(), words.size());
+    }
+
+    void ShaderReflection::merge(VkShaderStageFlagBits stage, ShaderLayout& layout) const {
+        if (!m_Valid) {
+            return;
+        }
+
+        for (const auto& variable : m_Variables) {
+            auto pointer = m_Types.find(variable.type);
+            if (pointer == m_Types.end()) {
+                continue;
+            }
+            uint32_t typeId = pointer->second.operands[1];
+            auto decorations = m_Decorations.find(variable.id);
+
+            switch (variable.storageClass) {
+                case UniformConstant:
+                case Uniform:
+                case StorageBuffer: {
+                    if (decorations == m_Decorations.end() || decorations->second.binding < 0) {
+                        break;
+                    }
+                    VkDescriptorSetLayoutBinding binding = {};
+                    binding.binding = static_cast<uint32_t>(decorations->second.binding);
+                    binding.descriptorCount = arrayLength(typeId);
+                    binding.stageFlags = stage;
+                    binding.descriptorType = variable.storageClass == StorageBuffer ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                                                                    : descriptorType(elementType(typeId));
+
+                    auto existing = std::find_if(layout.bindings.begin(), layout.bindings.end(),
+                                                 [&](const VkDescriptorSetLayoutBinding& other) {
+                                                     return other.binding == binding.binding;
+                                                 });
+                    if (existing != layout.bindings.end()) {
+                        existing->stageFlags |= stage;
+                        existing->descriptorCount = std::max(existing->descriptorCount, binding.descriptorCount);
+                    } else {
+                        layout.bindings.push_back(binding);
+                    }
+                    break;
+                }
+                case PushConstant: {
+                    layout.pushConstants.stageFlags |= stage;
+                    layout.pushConstants.size = std::max(layout.pushConstants.size, sizeOf(typeId));
+                    break;
+                }
+                case Input: {
+                    if (stage != VK_SHADER_STAGE_VERTEX_BIT || decorations == m_Decorations.end() ||
+                        decorations->second.location < 0 || decorations->second.builtIn) {
+                        break;
+                    }
+                    layout.vertexInputs.push_back({static_cast<uint32_t>(decorations->second.location), 0,
+                                                   vertexFormat(typeId), 0});
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        std::sort(layout.bindings.begin(), layout.bindings.end(),
+                  [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) {
+                      return a.binding < b.binding;
+                  });
+        std::sort(layout.vertexInputs.begin(), layout.vertexInputs.end(),
+                  [](const VkVertexInputAttributeDescription& a, const VkVertexInputAttributeDescription& b) {
+                      return a.location < b.location;
+                  });
+    }
+
+    void ShaderReflection::parse(const uint32_t* words, size_t wordCount) {
+        if (words[0] != SpirvMagic) {
+            fail("the code does not start with the SPIR-V magic number");
+            return;
+        }
+
+        // The first five words are the header
+        size_t index = 5;
+        while (index < wordCount) {
+            uint32_t instructionWords = words[index] >> 16;
+            uint32_t opcode = words[index] & 0xFFFF;
+            if (instructionWords == 0 || index + instructionWords > wordCount) {
+                fail("instruction at word " + std::to_string(index) + " is truncated");
+                return;
+            }
+            const uint32_t* instruction = words + index;
+
+            switch (opcode) {
+                case OpDecorate: {
+                    auto& decorations = m_Decorations[instruction[1]];
+                    uint32_t literal = instructionWords > 3 ? instruction[3] : 0;
+                    switch (instruction[2]) {
+                        case DescriptorSet: decorations.set = literal; break;
+                        case Binding:       decorations.binding = static_cast<int32_t>(literal); break;
+                        case Location:      decorations.location = static_cast<int32_t>(literal); break;
+                        case BuiltIn:       decorations.builtIn = true; break;
+                        case Block:         decorations.block = true; break;
+                        case BufferBlock:   decorations.bufferBlock = true; break;
+                        case ArrayStride:   decorations.arrayStride = literal; break;
+                        case SpecId:        m_SpecIds.push_back(literal); break;
+                        default: break;
+                    }
+                    break;
+                }
+                case OpMemberDecorate: {
+                    auto& decorations = m_Decorations[instruction[1]];
+                    uint32_t member = instruction[2];
+                    if (instruction[3] == BuiltIn) {
+                        // Blocks like gl_PerVertex
+                        decorations.builtIn = true;
+                        break;
+                    }
+                    if (decorations.members.size() <= member) {
+                        decorations.members.resize(member + 1);
+                    }
+                    switch (instruction[3]) {
+                        case Offset:       decorations.members[member].offset = instructionWords > 4 ? instruction[4] : 0; break;
+                        case MatrixStride: decorations.members[member].matrixStride = instructionWords > 4 ? instruction[4] : 0; break;
+                        case RowMajor:     decorations.members[member].rowMajor = true; break;
+                        case ColMajor:     decorations.members[member].rowMajor = false; break;
+                        default: break;
+                    }
+                    break;
+                }
+                case OpTypeVoid: case OpTypeBool: case OpTypeInt: case OpTypeFloat: case OpTypeVector:
+                case OpTypeMatrix: case OpTypeImage: case OpTypeSampler: case OpTypeSampledImage:
+                case OpTypeArray: case OpTypeRuntimeArray: case OpTypeStruct: case OpTypePointer: {
+                    m_Types[instruction[1]] = {opcode, std::vector<uint32_t>(instruction + 2, instruction + instructionWords)};
+                    break;
+                }
+                case OpConstant:
+                case OpSpecConstant: {
+                    if (instructionWords > 3) {
+                        m_Constants[instruction[2]] = instruction[3];
+                    }
+                    break;
+                }
+                case OpVariable: {
+                    m_Variables.push_back({instruction[2], instruction[1], instruction[3]});
+                    break;
+                }
+                default:
+                    break;
+            }
+            index += instructionWords;
+        }
+
+        // Pipelines are built around a single descriptor set
+        for (const auto& variable : m_Variables) {
+            auto decorations = m_Decorations.find(variable.id);
+            if (decorations != m_Decorations.end() && decorations->second.binding >= 0 && decorations->second.set != 0) {
+                fail("binding " + std::to_string(decorations->second.binding) + " is in descriptor set " +
+                     std::to_string(decorations->second.set) + ", only set 0 is supported");
+                return;
+            }
+        }
+    }
+
+    void ShaderReflection::fail(const std::string& error) {
+        m_Valid = false;
+        m_Error = error;
+    }
+
+    uint32_t ShaderReflection::sizeOf(uint32_t typeId, const Member* member) const {
+        auto found = m_Types.find(typeId);
+        if (found == m_Types.end()) {
+            return 0;
+        }
+        const auto& type = found->second;
+
+        switch (type.opcode) {
+            case OpTypeBool:
+                return 4;
+            case OpTypeInt:
+            case OpTypeFloat:
+                return type.operands[0] / 8;
+            case OpTypeVector:
+                return type.operands[1] * sizeOf(type.operands[0]);
+            case OpTypeMatrix: {
+                auto column = m_Types.find(type.operands[0]);
+                uint32_t rows = column != m_Types.end() ? column->second.operands[1] : 0;
+                if (member && member->matrixStride) {
+                    // The stride separates rows of a row major matrix and columns otherwise
+                    return (member->rowMajor ? rows : type.operands[1]) * member->matrixStride;
+                }
+                // Columns of three components are padded to four
+                uint32_t columnSize = sizeOf(type.operands[0]);
+                if (rows == 3) {
+                    columnSize = columnSize / 3 * 4;
+                }
+                return type.operands[1] * columnSize;
+            }
+            case OpTypeArray: {
+                auto decorations = m_Decorations.find(typeId);
+                uint32_t stride = decorations != m_Decorations.end() && decorations->second.arrayStride
+                                  ? decorations->second.arrayStride : sizeOf(type.operands[0], member);
+                auto length = m_Constants.find(type.operands[1]);
+                return length != m_Constants.end() ? length->second * stride : 0;
+            }
+            case OpTypeStruct: {
+                auto decorations = m_Decorations.find(typeId);
+                uint32_t size = 0;
+                uint32_t offset = 0;
+                for (size_t i = 0; i < type.operands.size(); i++) {
+                    const Member* layout = nullptr;
+                    if (decorations != m_Decorations.end() && i < decorations->second.members.size()) {
+                        layout = &decorations->second.members[i];
+                        offset = layout->offset;
+                    }
+                    uint32_t memberSize = sizeOf(type.operands[i], layout);
+                    size = std::max(size, offset + memberSize);
+                    offset += memberSize;
+                }
+                return size;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    uint32_t ShaderReflection::arrayLength(uint32_t typeId) const {
+        uint32_t length = 1;
+        auto found = m_Types.find(typeId);
+        while (found != m_Types.end() && found->second.opcode == OpTypeArray) {
+            auto constant = m_Constants.find(found->second.operands[1]);
+            length *= constant != m_Constants.end() ? constant->second : 1;
+            found = m_Types.find(found->second.operands[0]);
+        }
+        return length;
+    }
+
+    uint32_t ShaderReflection::elementType(uint32_t typeId) const {
+        auto found = m_Types.find(typeId);
+        while (found != m_Types.end() &&
+               (found->second.opcode == OpTypeArray || found->second.opcode == OpTypeRuntimeArray)) {
+            typeId = found->second.operands[0];
+            found = m_Types.find(typeId);
+        }
+        return typeId;
+    }
+
+    VkDescriptorType ShaderReflection::descriptorType(uint32_t typeId) const {
+        auto found = m_Types.find(typeId);
+        if (found == m_Types.end()) {
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        }
+        const auto& type = found->second;
+
+        switch (type.opcode) {
+            case OpTypeSampledImage:
+                return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            case OpTypeSampler:
+                return VK_DESCRIPTOR_TYPE_SAMPLER;
+            case OpTypeImage: {
+                uint32_t dim = type.operands[1];
+                bool storage = type.operands[5] == 2;
+                if (dim == DimSubpassData) {
+                    return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                }
+                if (dim == DimBuffer) {
+                    return storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                }
+                return storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            }
+            case OpTypeStruct: {
+                // Before SPIR-V 1.3 storage buffers are uniform blocks decorated as BufferBlock
+                auto decorations = m_Decorations.find(typeId);
+                if (decorations != m_Decorations.end() && decorations->second.bufferBlock) {
+                    return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                }
+                return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            }
+            default:
+                return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        }
+    }
+
+    VkFormat ShaderReflection::vertexFormat(uint32_t typeId) const {
+        auto found = m_Types.find(typeId);
+        if (found == m_Types.end()) {
+            return VK_FORMAT_UNDEFINED;
+        }
+
+        uint32_t components = 1;
+        auto scalar = found->second;
+        if (scalar.opcode == OpTypeVector) {
+            components = scalar.operands[1];
+            auto component = m_Types.find(scalar.operands[0]);
+            if (component == m_Types.end()) {
+                return VK_FORMAT_UNDEFINED;
+            }
+            scalar = component->second;
+        }
+        if (scalar.operands.empty() || scalar.operands[0] != 32 || components < 1 || components > 4) {
+            return VK_FORMAT_UNDEFINED;
+        }
+
+        static const VkFormat floatFormats[] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+                                                VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+        static const VkFormat intFormats[] = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT,
+                                              VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+        static const VkFormat uintFormats[] = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT,
+                                               VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+        if (scalar.opcode == OpTypeFloat) {
+            return floatFormats[components - 1];
+        }
+        if (scalar.opcode == OpTypeInt) {
+            return scalar.operands[1] ? intFormats[components - 1] : uintFormats[components - 1];
+        }
+        return VK_FORMAT_UNDEFINED;
+    }
+}
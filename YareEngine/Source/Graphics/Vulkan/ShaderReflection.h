@@ -0,0 +1,90 @@
+#ifndef YARE_SHADER_REFLECTION_H
+#define YARE_SHADER_REFLECTION_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Yare::Graphics {
+
+    // The interface of a shader as the pipeline layout and vertex input state see it
+    struct ShaderLayout {
+        // Descriptor set 0, sorted by binding, the stage flags of every stage that uses a binding
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        // Size is 0 when no stage declares push constants
+        VkPushConstantRange pushConstants = {0, 0, 0};
+        // Locations and formats of the vertex stage inputs, binding and offset are left to the caller
+        std::vector<VkVertexInputAttributeDescription> vertexInputs;
+    };
+
+    // Reads the resources a SPIR-V module declares, only the subset of the format that
+    // describes descriptors, push constants and stage inputs is understood
+    class ShaderReflection {
+    public:
+        ShaderReflection(const std::vector<char>& code);
+
+        // False if the code is not SPIR-V or uses a resource that can't be described
+        bool isValid() const { return m_Valid; }
+        const std::string& getError() const { return m_Error; }
+
+        // Adds the resources of this stage to the layout, bindings shared with other stages are merged
+        void merge(VkShaderStageFlagBits stage, ShaderLayout& layout) const;
+        // Constant ids of the specialization constants the module declares
+        const std::vector<uint32_t>& getSpecIds() const { return m_SpecIds; }
+
+    private:
+        struct Type {
+            uint32_t opcode = 0;
+            std::vector<uint32_t> operands;
+        };
+
+        // Layout decorations of one struct member
+        struct Member {
+            uint32_t offset = 0;
+            uint32_t matrixStride = 0;
+            bool rowMajor = false;
+        };
+
+        struct Decorations {
+            uint32_t set = 0;
+            int32_t binding = -1;
+            int32_t location = -1;
+            bool builtIn = false;
+            bool block = false;
+            bool bufferBlock = false;
+            uint32_t arrayStride = 0;
+            // Per member of a struct
+            std::vector<Member> members;
+        };
+
+        struct Variable {
+            uint32_t id;
+            uint32_t type;
+            uint32_t storageClass;
+        };
+
+        void parse(const uint32_t* words, size_t wordCount);
+        void fail(const std::string& error);
+
+        // A matrix member is sized with the stride it is decorated with, passed down through arrays of matrices
+        uint32_t sizeOf(uint32_t typeId, const Member* member = nullptr) const;
+        uint32_t arrayLength(uint32_t typeId) const;
+        VkDescriptorType descriptorType(uint32_t typeId) const;
+        VkFormat vertexFormat(uint32_t typeId) const;
+        uint32_t elementType(uint32_t typeId) const;
+
+    private:
+        bool m_Valid = true;
+        std::string m_Error;
+
+        std::unordered_map<uint32_t, Type> m_Types;
+        std::unordered_map<uint32_t, uint32_t> m_Constants;
+        std::unordered_map<uint32_t, Decorations> m_Decorations;
+        std::vector<Variable> m_Variables;
+        std::vector<uint32_t> m_SpecIds;
+    };
+}
+
+#endif // YARE_SHADER_REFLECTION_H
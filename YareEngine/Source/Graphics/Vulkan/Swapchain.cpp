@@ -1,11 +1,15 @@
 #include "Graphics/Vulkan/Swapchain.h"
 #include "Graphics/Vulkan/Devices.h"
+#include "Graphics/Vulkan/Context.h"
 #include "Graphics/Vulkan/Utilities.h"
 #include "Utilities/Logger.h"
 
+#include <algorithm>
+
 namespace Yare::Graphics {
 
-    Swapchain::Swapchain(size_t width, size_t height) {
+    Swapchain::Swapchain(size_t width, size_t height, PresentMode presentMode, uint32_t imageCount)
+        : m_RequestedMode(presentMode), m_RequestedImageCount(imageCount) {
         init(width, height);
     }
 
@@ -20,13 +24,19 @@ namespace Yare::Graphics {
     }
 
     void Swapchain::onResize(size_t width, size_t height) {
-        //Cleanup
-        {
-            for (auto& imageView : m_SwapchainImageViews) {
+        // Frames still in flight may be presenting the old images, retire them once those have completed
+        auto& deletionQueue = VulkanContext::getContext()->getDeletionQueue();
+        auto oldSwapchain = m_Swapchain;
+        auto oldImageViews = m_SwapchainImageViews;
+
+        init(width, height);
+
+        deletionQueue->push([oldSwapchain, oldImageViews] {
+            for (auto& imageView : oldImageViews) {
                 vkDestroyImageView(Devices::instance()->getDevice(), imageView, nullptr);
             }
-        }
-        init(width, height);
+            vkDestroySwapchainKHR(Devices::instance()->getDevice(), oldSwapchain, nullptr);
+        });
     }
 
     void Swapchain::init(size_t width, size_t height) {
@@ -61,12 +71,16 @@ namespace Yare::Graphics {
 
         SwapChainSupportDetails swapChainSupport = YzVkDeviceinstance->getSwapChainSupport();
 
+        m_CreatedMode = m_RequestedMode;
+        m_CreatedImageCount = m_RequestedImageCount;
+
         auto surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-        auto presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+        auto presentMode = chooseSwapPresentMode(swapChainSupport.presentModes, m_RequestedMode);
         auto extent = chooseSwapExtent(swapChainSupport.capabilities, width, height);
 
-        // Request one more image to render to than the minimum so we dont wait for driver operations
-        uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+        // More images let the CPU run further ahead at the cost of latency
+        uint32_t imageCount = std::max(std::max(m_RequestedImageCount, 1u),
+                                       swapChainSupport.capabilities.minImageCount);
 
         if (swapChainSupport.capabilities.maxImageCount > 0 &&
                 imageCount > swapChainSupport.capabilities.maxImageCount) {
@@ -82,6 +96,11 @@ namespace Yare::Graphics {
         createInfo.imageExtent = extent;
         createInfo.imageArrayLayers = 1;
         createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        // Lets frames be read back, most surfaces support it
+        m_Readable = swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        if (m_Readable) {
+            createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
 
         // In the event that this creation function is being called twice,
         // We need to 'retire' the old swapchain
@@ -121,6 +140,17 @@ namespace Yare::Graphics {
 
         m_SwapchainImageFormat = surfaceFormat.format;
         m_SwapchainExtent = extent;
+
+        YZ_INFO("Swapchain created with " + STR(imageCount) + " images, present mode " + STR(presentMode));
+    }
+
+    void Swapchain::setPresentMode(PresentMode mode, uint32_t imageCount) {
+        m_RequestedMode = mode;
+        m_RequestedImageCount = imageCount;
+    }
+
+    bool Swapchain::isOutdated() const {
+        return m_RequestedMode != m_CreatedMode || m_RequestedImageCount != m_CreatedImageCount;
     }
 
     void Swapchain::createImageViews() {
@@ -142,11 +172,25 @@ namespace Yare::Graphics {
         return availableFormats[0];
     }
 
-    VkPresentModeKHR Swapchain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
-        for (const auto& availablePresentMode : availablePresentModes) {
-            if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR ||
-                availablePresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-                return availablePresentMode;
+    VkPresentModeKHR Swapchain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes,
+                                                      PresentMode mode) {
+        // Preferred mode first, FIFO is the only one every surface is required to support
+        std::vector<VkPresentModeKHR> candidates;
+        switch (mode) {
+            case PresentMode::LowLatency:
+                candidates = {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR};
+                break;
+            case PresentMode::Throughput:
+                candidates = {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR};
+                break;
+            default:
+                break;
+        }
+
+        for (auto candidate : candidates) {
+            if (std::find(availablePresentModes.begin(), availablePresentModes.end(), candidate) !=
+                availablePresentModes.end()) {
+                return candidate;
             }
         }
         return VK_PRESENT_MODE_FIFO_KHR;
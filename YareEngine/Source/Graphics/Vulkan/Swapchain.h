@@ -2,34 +2,42 @@
 #define YARE_SWAPCHAIN_H
 
 #include "Graphics/Vulkan/Vk.h"
+#include "Graphics/Vulkan/RenderTarget.h"
 
 #include <vector>
 
 namespace Yare::Graphics {
-    class Swapchain {
+    class Swapchain : public RenderTarget {
     public:
-        Swapchain(size_t width, size_t height);
+        // The image count is clamped to what the surface supports
+        Swapchain(size_t width, size_t height, PresentMode presentMode, uint32_t imageCount);
         ~Swapchain();
 
-        VkResult present(VkSemaphore waitSemaphore);
-        VkResult acquireNextImage(VkSemaphore signalSemaphore);
-        void     onResize(size_t width, size_t height);
+        VkResult present(VkSemaphore waitSemaphore) override;
+        VkResult acquireNextImage(VkSemaphore signalSemaphore) override;
+        void     onResize(size_t width, size_t height) override;
+        void     setPresentMode(PresentMode mode, uint32_t imageCount) override;
+        bool     isOutdated() const override;
+        bool     isPresentable() const override { return true; }
+        bool     isReadable() const override { return m_Readable; }
 
         const VkSwapchainKHR&   getSwapchain()                  const { return m_Swapchain; }
         const size_t            getImagesSize()                 const { return m_SwapchainImages.size(); }
-        const size_t            getImageViewSize()              const { return m_SwapchainImageViews.size(); }
-        const VkImage&          getImage(uint32_t index)        const { return m_SwapchainImages[index]; }
-        const VkImageView&      getImageView(uint32_t index)    const { return m_SwapchainImageViews[index]; }
-        const VkFormat&         getImageFormat()                const { return m_SwapchainImageFormat; }
-        const VkExtent2D&       getExtent()                     const { return m_SwapchainExtent; }
-        const uint32_t          getCurrentImage()               const { return m_CurrentImage; }
+        size_t                  getImageViewSize()              const override { return m_SwapchainImageViews.size(); }
+        const VkImage&          getImage(uint32_t index)        const override { return m_SwapchainImages[index]; }
+        const VkImageView&      getImageView(uint32_t index)    const override { return m_SwapchainImageViews[index]; }
+        const VkFormat&         getImageFormat()                const override { return m_SwapchainImageFormat; }
+        const VkExtent2D&       getExtent()                     const override { return m_SwapchainExtent; }
+        uint32_t                getCurrentImage()               const override { return m_CurrentImage; }
+        VkImageLayout           getFinalLayout()                const override { return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; }
 
     private:
         void init(size_t width, size_t height);
         void createSwapchain(size_t width, size_t height);
         void createImageViews();
         VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
-        VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+        VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes,
+                                               PresentMode mode);
         VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, size_t width, size_t height);
     private:
         VkSwapchainKHR           m_Swapchain = VK_NULL_HANDLE;
@@ -38,6 +46,12 @@ namespace Yare::Graphics {
         std::vector<VkImage>     m_SwapchainImages;
         std::vector<VkImageView> m_SwapchainImageViews;
         uint32_t                 m_CurrentImage = 0;
+        bool                     m_Readable = false;
+        // What the swapchain is to be created for, not necessarily what the surface gives us
+        PresentMode              m_RequestedMode = PresentMode::Throughput;
+        uint32_t                 m_RequestedImageCount = 0;
+        PresentMode              m_CreatedMode = PresentMode::Throughput;
+        uint32_t                 m_CreatedImageCount = 0;
     };
 }
 
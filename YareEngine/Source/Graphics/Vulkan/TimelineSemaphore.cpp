@@ -0,0 +1,78 @@
+#include "Graphics/Vulkan/TimelineSemaphore.h"
+#include "Graphics/Vulkan/Devices.h"
+#include "Utilities/Logger.h"
+
+namespace Yare::Graphics {
+
+    PFN_vkGetSemaphoreCounterValueKHR TimelineSemaphore::s_GetSemaphoreCounterValue = nullptr;
+    PFN_vkWaitSemaphoresKHR           TimelineSemaphore::s_WaitSemaphores = nullptr;
+    PFN_vkSignalSemaphoreKHR          TimelineSemaphore::s_SignalSemaphore = nullptr;
+
+    void TimelineSemaphore::loadFunctions(VkDevice device) {
+        s_GetSemaphoreCounterValue = (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(device,
+                                                                                            "vkGetSemaphoreCounterValueKHR");
+        s_WaitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR");
+        s_SignalSemaphore = (PFN_vkSignalSemaphoreKHR)vkGetDeviceProcAddr(device, "vkSignalSemaphoreKHR");
+
+        if (!s_GetSemaphoreCounterValue || !s_WaitSemaphores || !s_SignalSemaphore) {
+            YZ_CRITICAL("Vulkan failed to load the timeline semaphore functions.");
+        }
+    }
+
+    TimelineSemaphore::TimelineSemaphore(uint64_t initialValue)
+        : m_PendingValue(initialValue) {
+        VkSemaphoreTypeCreateInfoKHR typeInfo = {};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = initialValue;
+
+        VkSemaphoreCreateInfo sInfo = {};
+        sInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        sInfo.pNext = &typeInfo;
+
+        auto res = vkCreateSemaphore(Devices::instance()->getDevice(), &sInfo, nullptr, &m_Semaphore);
+        if (res != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to create a timeline semaphore");
+        }
+    }
+
+    TimelineSemaphore::~TimelineSemaphore() {
+        if (m_Semaphore) {
+            vkDestroySemaphore(Devices::instance()->getDevice(), m_Semaphore, nullptr);
+        }
+    }
+
+    uint64_t TimelineSemaphore::getCompletedValue() const {
+        uint64_t value = 0;
+        s_GetSemaphoreCounterValue(Devices::instance()->getDevice(), m_Semaphore, &value);
+        return value;
+    }
+
+    bool TimelineSemaphore::wait(uint64_t value, uint64_t timeout) const {
+        VkSemaphoreWaitInfoKHR waitInfo = {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_Semaphore;
+        waitInfo.pValues = &value;
+
+        auto res = s_WaitSemaphores(Devices::instance()->getDevice(), &waitInfo, timeout);
+        if (res != VK_SUCCESS && res != VK_TIMEOUT) {
+            YZ_CRITICAL("Vulkan failed to wait on a timeline semaphore.");
+        }
+        return res == VK_SUCCESS;
+    }
+
+    void TimelineSemaphore::signal(uint64_t value) {
+        VkSemaphoreSignalInfoKHR signalInfo = {};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        signalInfo.semaphore = m_Semaphore;
+        signalInfo.value = value;
+
+        if (s_SignalSemaphore(Devices::instance()->getDevice(), &signalInfo) != VK_SUCCESS) {
+            YZ_CRITICAL("Vulkan failed to signal a timeline semaphore.");
+        }
+        if (value > m_PendingValue) {
+            m_PendingValue = value;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef YARE_TIMELINE_SEMAPHORE_H
+#define YARE_TIMELINE_SEMAPHORE_H
+
+#include "Graphics/Vulkan/Vk.h"
+
+namespace Yare::Graphics {
+
+    // A semaphore holding a monotonically increasing 64 bit value. Every submission that signals it
+    // gets its own value, which the CPU or other submissions can then wait on or poll.
+    class TimelineSemaphore {
+    public:
+        TimelineSemaphore(uint64_t initialValue = 0);
+        ~TimelineSemaphore();
+
+        // Reserves the next value for a submission to signal
+        uint64_t nextValue() { return ++m_PendingValue; }
+
+        // Last value handed out by nextValue, reached once all work submitted so far has completed
+        uint64_t getPendingValue()   const { return m_PendingValue; }
+        uint64_t getCompletedValue() const;
+        bool     isComplete(uint64_t value) const { return getCompletedValue() >= value; }
+
+        // Blocks until the semaphore has reached value, returns false on timeout
+        bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+        // Signals from the host, value must be greater than the current one
+        void signal(uint64_t value);
+
+        const VkSemaphore& getSemaphore() const { return m_Semaphore; }
+
+        // The KHR entry points are not exported by the loader, they are fetched once the device exists
+        static void loadFunctions(VkDevice device);
+
+    private:
+        VkSemaphore m_Semaphore = VK_NULL_HANDLE;
+        uint64_t    m_PendingValue;
+
+        static PFN_vkGetSemaphoreCounterValueKHR s_GetSemaphoreCounterValue;
+        static PFN_vkWaitSemaphoresKHR           s_WaitSemaphores;
+        static PFN_vkSignalSemaphoreKHR          s_SignalSemaphore;
+    };
+}
+
+#endif // YARE_TIMELINE_SEMAPHORE_H
@@ -60,21 +60,50 @@ namespace Yare::Graphics::VkUtil {
     void endSingleTimeCommands(VkCommandBuffer commandBuffer) {
         vkEndCommandBuffer(commandBuffer);
 
+        // Only wait for this upload, not for whatever else is in flight on the queue
+        auto& uploadTimeline = VulkanContext::getContext()->getUploadTimeline();
+        uint64_t signalValue = uploadTimeline->nextValue();
+
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &signalValue;
+
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &uploadTimeline->getSemaphore();
 
         vkQueueSubmit(Devices::instance()->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(Devices::instance()->getGraphicsQueue());
+        uploadTimeline->wait(signalValue);
 
         vkFreeCommandBuffers(Devices::instance()->getDevice(),
                              VulkanContext::getContext()->getCommandPool()->getPool(),
                              1, &commandBuffer);
     }
 
+    void submitSingleTimeCommands(VkCommandBuffer commandBuffer) {
+        vkEndCommandBuffer(commandBuffer);
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        vkQueueSubmit(Devices::instance()->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+
+        // The frame is submitted after this, it completing means this has as well
+        VkDevice device = Devices::instance()->getDevice();
+        VkCommandPool pool = VulkanContext::getContext()->getCommandPool()->getPool();
+        VulkanContext::getContext()->getDeletionQueue()->push([device, pool, commandBuffer]() {
+            vkFreeCommandBuffers(device, pool, 1, &commandBuffer);
+        });
+    }
+
     VkImageView createImageView(VkImage image, VkImageViewType viewType, VkFormat format,
-                                uint32_t layerCount, VkImageAspectFlags aspectFlags) {
+                                uint32_t layerCount, VkImageAspectFlags aspectFlags, uint32_t mipLevels) {
         VkImageViewCreateInfo viewInfo = {};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image = image;
@@ -82,7 +111,7 @@ namespace Yare::Graphics::VkUtil {
         viewInfo.format = format;
         viewInfo.subresourceRange.aspectMask = aspectFlags;
         viewInfo.subresourceRange.baseMipLevel = 0;
-        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.levelCount = mipLevels;
         viewInfo.subresourceRange.baseArrayLayer = 0;
         viewInfo.subresourceRange.layerCount = layerCount;
 
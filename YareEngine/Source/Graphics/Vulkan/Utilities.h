@@ -11,8 +11,12 @@ namespace Yare::Graphics::VkUtil {
 
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+    // Submits without waiting, the command buffer is freed once the frame being recorded has completed.
+    // Frames submitted later only see its writes through the barriers it recorded.
+    void submitSingleTimeCommands(VkCommandBuffer commandBuffer);
 
-    VkImageView createImageView(VkImage image, VkImageViewType viewType, VkFormat format, uint32_t layerCount, VkImageAspectFlags aspectFlags);
+    VkImageView createImageView(VkImage image, VkImageViewType viewType, VkFormat format, uint32_t layerCount,
+                                VkImageAspectFlags aspectFlags, uint32_t mipLevels = 1);
 
     VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
     VkFormat findDepthFormat();
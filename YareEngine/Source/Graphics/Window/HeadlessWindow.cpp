@@ -0,0 +1,14 @@
+#include "Graphics/Window/HeadlessWindow.h"
+#include "Graphics/Camera/FpsCamera.h"
+
+namespace Yare::Graphics {
+
+    std::shared_ptr<Window> Window::createHeadlessWindow(WindowProperties& properties) {
+        return std::make_shared<HeadlessWindow>(properties);
+    }
+
+    HeadlessWindow::HeadlessWindow(WindowProperties& properties) {
+        m_Properties = properties;
+        m_Camera = std::make_shared<FpsCamera>(m_Properties.width, m_Properties.height);
+    }
+}
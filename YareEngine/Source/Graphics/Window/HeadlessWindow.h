@@ -0,0 +1,27 @@
+#ifndef YARE_HEADLESS_WINDOW_H
+#define YARE_HEADLESS_WINDOW_H
+
+#include "Graphics/Window/Window.h"
+
+namespace Yare::Graphics {
+    // Stands in for a window on machines without a display. It owns the camera like any other
+    // window, but never polls input and only closes when asked to.
+    class HeadlessWindow : public Window {
+    public:
+        HeadlessWindow(WindowProperties& properties);
+        virtual ~HeadlessWindow() = default;
+
+        virtual void onUpdate() override {}
+        virtual bool shouldClose() override { return m_ShouldClose; }
+        virtual void close() override { m_ShouldClose = true; }
+        virtual void releaseInputHandling() override {}
+
+        virtual void* getNativeWindow() const override { return nullptr; }
+        virtual bool isHeadless() const override { return true; }
+
+    private:
+        bool m_ShouldClose = false;
+    };
+}
+
+#endif // YARE_HEADLESS_WINDOW_H
@@ -29,7 +29,10 @@ namespace Yare::Graphics {
         virtual std::shared_ptr<Camera>         getCamera()            const { return m_Camera; }
 
         static std::shared_ptr<Window> createNewWindow(WindowProperties& properties);
+        // A window that is never shown, frames are rendered offscreen and there is no input
+        static std::shared_ptr<Window> createHeadlessWindow(WindowProperties& properties);
         virtual void* getNativeWindow() const = 0;
+        virtual bool isHeadless() const { return false; }
 
         bool windowResized = false;
         bool windowIsFocused = true;
@@ -0,0 +1,154 @@
+#include "Utilities/AsyncLogSink.h"
+
+#include <cstdio>
+
+namespace Yare::Utilities {
+
+    AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks)
+        : m_Sinks(std::move(sinks)), m_Slots(new Slot[QUEUE_SIZE]) {
+        for (uint32_t i = 0; i < QUEUE_SIZE; i++) {
+            m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_Writer = std::thread(&AsyncLogSink::run, this);
+    }
+
+    AsyncLogSink::~AsyncLogSink() {
+        m_Running.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+        }
+        m_WakeCondition.notify_one();
+        if (m_Writer.joinable()) {
+            m_Writer.join();
+        }
+    }
+
+    void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+        // Bounded multi producer ring, a slot's sequence tells whether the lap before has been written
+        auto position = m_Tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_Slots[position & (QUEUE_SIZE - 1)];
+            auto sequence = slot->sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0) {
+                if (m_Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                position = m_Tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = msg.level;
+        slot->time = msg.time;
+        slot->threadId = msg.thread_id;
+        slot->loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+        slot->payload.assign(msg.payload.data(), msg.payload.size());
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        // Pairs with the fence in run, either the writer sees the message or this sees it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Sleeping.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard<std::mutex> lock(m_WakeMutex);
+            }
+            m_WakeCondition.notify_one();
+        }
+    }
+
+    void AsyncLogSink::flush() {
+        if (std::this_thread::get_id() == m_Writer.get_id()) {
+            return;
+        }
+        auto target = m_Tail.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_WrittenCondition.wait(lock, [&]() { return m_Written.load(std::memory_order_acquire) >= target; });
+    }
+
+    void AsyncLogSink::set_pattern(const std::string& pattern) {
+        for (auto& sink : m_Sinks) {
+            sink->set_pattern(pattern);
+        }
+    }
+
+    void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) {
+        for (size_t i = 0; i < m_Sinks.size(); i++) {
+            m_Sinks[i]->set_formatter(i + 1 < m_Sinks.size() ? sinkFormatter->clone() : std::move(sinkFormatter));
+        }
+    }
+
+    void AsyncLogSink::run() {
+        while (m_Running.load(std::memory_order_acquire)) {
+            if (drain() > 0) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_Sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_WakeCondition.wait(lock, [this]() { return hasWork() || !m_Running.load(std::memory_order_acquire); });
+            m_Sleeping.store(false, std::memory_order_relaxed);
+        }
+        // Whatever was logged before the sink was destroyed
+        drain();
+    }
+
+    uint64_t AsyncLogSink::drain() {
+        uint64_t count = 0;
+        for (;;) {
+            auto& slot = m_Slots[m_Head & (QUEUE_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_Head + 1) {
+                break;
+            }
+            spdlog::details::log_msg msg(slot.loggerName, slot.level, slot.payload);
+            msg.time = slot.time;
+            msg.thread_id = slot.threadId;
+            write(msg);
+
+            // Free for the producer one lap later
+            slot.sequence.store(m_Head + QUEUE_SIZE, std::memory_order_release);
+            m_Head++;
+            count++;
+        }
+
+        auto dropped = m_Dropped.load(std::memory_order_relaxed);
+        if (dropped != m_ReportedDropped) {
+            auto message = std::to_string(dropped - m_ReportedDropped) + " log messages were dropped, the queue was full";
+            write(spdlog::details::log_msg("Yare", spdlog::level::warn, message));
+            m_ReportedDropped = dropped;
+        }
+
+        if (count > 0) {
+            for (auto& sink : m_Sinks) {
+                sink->flush();
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_WakeMutex);
+                m_Written.store(m_Head, std::memory_order_release);
+            }
+            m_WrittenCondition.notify_all();
+        }
+        return count;
+    }
+
+    bool AsyncLogSink::hasWork() const {
+        return m_Slots[m_Head & (QUEUE_SIZE - 1)].sequence.load(std::memory_order_acquire) == m_Head + 1 ||
+               m_Dropped.load(std::memory_order_relaxed) != m_ReportedDropped;
+    }
+
+    void AsyncLogSink::write(const spdlog::details::log_msg& msg) {
+        // A failed write only loses that message, the writer keeps going
+        for (auto& sink : m_Sinks) {
+            try {
+                if (sink->should_log(msg.level)) {
+                    sink->log(msg);
+                }
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "Could not write a log message: %s\n", e.what());
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef YARE_ASYNC_LOG_SINK_H
+#define YARE_ASYNC_LOG_SINK_H
+
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Yare::Utilities {
+
+    // Hands messages to a background thread that writes them to the wrapped sinks. spdlog has already
+    // formatted the arguments into the payload on the thread that logs, the sink copies it, and the
+    // pattern, the timestamp and the file or console write run on the writer thread.
+    // Threads claim a slot of a bounded ring with a compare and swap and never wait for the writer or for
+    // each other. When the ring is full the message is dropped, the writer reports how many were.
+    // An idle writer sleeps on a condition variable, a thread that logs only takes its mutex to wake it.
+    class AsyncLogSink : public spdlog::sinks::sink {
+    public:
+        static constexpr uint32_t QUEUE_SIZE = 1 << 12;
+
+        // The sinks are only used by the writer thread, they don't need to be thread safe
+        explicit AsyncLogSink(std::vector<spdlog::sink_ptr> sinks);
+        // Writes every message still queued before returning
+        ~AsyncLogSink() override;
+
+        void log(const spdlog::details::log_msg& msg) override;
+        // Blocks until every message logged before the call has been written and the sinks flushed
+        void flush() override;
+        // Only safe before the first message is logged
+        void set_pattern(const std::string& pattern) override;
+        void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+        uint64_t getDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot {
+            // Equals the position a producer may claim the slot at, position + 1 once it is published
+            std::atomic<uint64_t>     sequence{0};
+            spdlog::level::level_enum level = spdlog::level::off;
+            spdlog::log_clock::time_point time;
+            size_t                    threadId = 0;
+            // Keep their capacity between messages, so logging only allocates until the slot has seen
+            // its longest message. The logger may be gone by the time the message is written.
+            std::string               loggerName;
+            std::string               payload;
+        };
+
+        void run();
+        // Writes the published messages, returns how many there were
+        uint64_t drain();
+        // True when a message is published or a drop has not been reported yet, only called by the writer
+        bool hasWork() const;
+        void write(const spdlog::details::log_msg& msg);
+
+    private:
+        std::vector<spdlog::sink_ptr> m_Sinks;
+        std::unique_ptr<Slot[]> m_Slots;
+
+        alignas(64) std::atomic<uint64_t> m_Tail{0};
+        // Only advanced by the writer, everything before it has been written and flushed
+        alignas(64) std::atomic<uint64_t> m_Written{0};
+        uint64_t m_Head = 0;
+        std::atomic<uint64_t> m_Dropped{0};
+        uint64_t m_ReportedDropped = 0;
+
+        std::atomic<bool> m_Running{true};
+        // Set while the writer is about to wait or waiting, so logging skips the mutex otherwise
+        std::atomic<bool> m_Sleeping{false};
+        std::mutex m_WakeMutex;
+        // Wakes the writer when a message is published or the sink is destroyed
+        std::condition_variable m_WakeCondition;
+        // Wakes flush when the writer has written a batch
+        std::condition_variable m_WrittenCondition;
+        std::thread m_Writer;
+    };
+}
+
+#endif // YARE_ASYNC_LOG_SINK_H
@@ -0,0 +1,127 @@
+#include "Utilities/ImageWriter.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <vector>
+
+namespace Yare::Utilities {
+
+    namespace {
+        void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+            out.push_back(static_cast<uint8_t>(value >> 24));
+            out.push_back(static_cast<uint8_t>(value >> 16));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        uint32_t crc32(const uint8_t* data, size_t size) {
+            static const auto table = [] {
+                std::array<uint32_t, 256> entries{};
+                for (uint32_t i = 0; i < 256; i++) {
+                    uint32_t c = i;
+                    for (int bit = 0; bit < 8; bit++) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    entries[i] = c;
+                }
+                return entries;
+            }();
+
+            uint32_t crc = 0xFFFFFFFFu;
+            for (size_t i = 0; i < size; i++) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return crc ^ 0xFFFFFFFFu;
+        }
+
+        void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+            appendBigEndian(out, static_cast<uint32_t>(data.size()));
+            size_t start = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data.begin(), data.end());
+            appendBigEndian(out, crc32(out.data() + start, out.size() - start));
+        }
+
+        bool writePng(std::ofstream& file, uint32_t width, uint32_t height, const uint8_t* pixels) {
+            // Every scanline starts with its filter type, none
+            size_t rowSize = static_cast<size_t>(width) * 4;
+            std::vector<uint8_t> scanlines;
+            scanlines.reserve((rowSize + 1) * height);
+            for (uint32_t y = 0; y < height; y++) {
+                scanlines.push_back(0);
+                scanlines.insert(scanlines.end(), pixels + y * rowSize, pixels + (y + 1) * rowSize);
+            }
+
+            // A zlib stream of stored deflate blocks, compression is left to whoever archives the frames
+            std::vector<uint8_t> stream = {0x78, 0x01};
+            const size_t maxBlockSize = 0xFFFF;
+            size_t offset = 0;
+            do {
+                size_t blockSize = std::min(maxBlockSize, scanlines.size() - offset);
+                bool last = offset + blockSize == scanlines.size();
+                stream.push_back(last ? 1 : 0);
+                stream.push_back(static_cast<uint8_t>(blockSize));
+                stream.push_back(static_cast<uint8_t>(blockSize >> 8));
+                stream.push_back(static_cast<uint8_t>(~blockSize));
+                stream.push_back(static_cast<uint8_t>(~blockSize >> 8));
+                stream.insert(stream.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+                offset += blockSize;
+            } while (offset < scanlines.size());
+
+            uint32_t a = 1, b = 0;
+            for (auto byte : scanlines) {
+                a = (a + byte) % 65521;
+                b = (b + a) % 65521;
+            }
+            appendBigEndian(stream, (b << 16) | a);
+
+            std::vector<uint8_t> header;
+            appendBigEndian(header, width);
+            appendBigEndian(header, height);
+            // 8 bits per channel, RGBA, deflate, adaptive filtering, no interlacing
+            header.insert(header.end(), {8, 6, 0, 0, 0});
+
+            std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            appendChunk(png, "IHDR", header);
+            appendChunk(png, "IDAT", stream);
+            appendChunk(png, "IEND", {});
+
+            file.write(reinterpret_cast<const char*>(png.data()), png.size());
+            return static_cast<bool>(file);
+        }
+
+        bool writePpm(std::ofstream& file, uint32_t width, uint32_t height, const uint8_t* pixels) {
+            file << "P6\n" << width << " " << height << "\n255\n";
+            std::vector<uint8_t> rgb;
+            rgb.reserve(static_cast<size_t>(width) * height * 3);
+            for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+                rgb.insert(rgb.end(), pixels + i * 4, pixels + i * 4 + 3);
+            }
+            file.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+            return static_cast<bool>(file);
+        }
+
+        bool writeRaw(std::ofstream& file, uint32_t width, uint32_t height, const uint8_t* pixels) {
+            file.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(width) * height * 4);
+            return static_cast<bool>(file);
+        }
+    }
+
+    bool writeImage(const std::string& filePath, uint32_t width, uint32_t height, const uint8_t* pixels) {
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        auto dot = filePath.find_last_of('.');
+        auto extension = dot != std::string::npos ? filePath.substr(dot) : std::string();
+        if (extension == ".ppm") {
+            return writePpm(file, width, height, pixels);
+        }
+        if (extension == ".raw") {
+            return writeRaw(file, width, height, pixels);
+        }
+        return writePng(file, width, height, pixels);
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef YARE_IMAGE_WRITER_H
+#define YARE_IMAGE_WRITER_H
+
+#include <cstdint>
+#include <string>
+
+namespace Yare::Utilities {
+    // Writes tightly packed RGBA8 pixels, top row first. The format follows the extension, .ppm drops
+    // the alpha channel, .raw writes the pixels as they are and anything else is written as an
+    // uncompressed PNG. Returns false if the file could not be written.
+    bool writeImage(const std::string& filePath, uint32_t width, uint32_t height, const uint8_t* pixels);
+}
+
+#endif // YARE_IMAGE_WRITER_H
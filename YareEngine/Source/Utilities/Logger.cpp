@@ -1,4 +1,5 @@
 #include "Utilities/Logger.h"
+#include "Utilities/AsyncLogSink.h"
 
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -14,7 +15,7 @@ namespace Yare {
     std::string Logger::m_FileOutputPath;
     std::string Logger::m_currentLogFileName;
 
-    void Logger::init() {
+    void Logger::init(bool async) {
         // Get the Date/Time stamp to generate a new logfile
         time_t timeinfo  = std::time(nullptr);
         char buff[50];
@@ -31,9 +32,27 @@ namespace Yare {
         m_currentLogFileName = buff;
 
         std::vector<spdlog::sink_ptr> sinks;
-        sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_st>("Logs/" + m_currentLogFileName));
-        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
+        if (async) {
+            // Only the writer thread uses the sinks
+            sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_st>("Logs/" + m_currentLogFileName));
+            sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
+            sinks = {std::make_shared<Utilities::AsyncLogSink>(std::move(sinks))};
+        } else {
+            // Any thread may log, so the sinks lock around each write
+            sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("Logs/" + m_currentLogFileName));
+            sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        }
         m_EngineLogger = std::make_shared<spdlog::logger>("Yare", begin(sinks), end(sinks));
+        // What is compiled in is logged, YZ_LOG_LEVEL does the filtering
+        m_EngineLogger->set_level(spdlog::level::trace);
+        // Errors are often followed by an exception that may end the process, they must not wait in the queue
+        m_EngineLogger->flush_on(spdlog::level::err);
+    }
+
+    void Logger::flush() {
+        if (m_EngineLogger) {
+            m_EngineLogger->flush();
+        }
     }
 
     void Logger::changeFilePath(const std::string& path) {
@@ -3,16 +3,49 @@
 #include "Core/Core.h"
 
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <spdlog/spdlog.h>
 
+#define YZ_LOG_LEVEL_TRACE      0
+#define YZ_LOG_LEVEL_DEBUG      1
+#define YZ_LOG_LEVEL_INFO       2
+#define YZ_LOG_LEVEL_WARN       3
+#define YZ_LOG_LEVEL_ERROR      4
+
+// Messages below this level are compiled out along with their arguments, set with YARE_LOG_LEVEL.
+// Critical errors are never compiled out, they throw.
+#ifndef YZ_LOG_LEVEL
+#ifdef NDEBUG
+#define YZ_LOG_LEVEL YZ_LOG_LEVEL_INFO
+#else
+#define YZ_LOG_LEVEL YZ_LOG_LEVEL_TRACE
+#endif
+#endif
+
+// Messages are written by a background thread unless YARE_SYNC_LOGGING is set
+#ifndef YZ_LOG_ASYNC
+#define YZ_LOG_ASYNC 1
+#endif
+
 namespace Yare {
     class Logger {
     public:
-        static void init();
+        // An asynchronous logger formats the arguments into the payload and copies it on the calling thread,
+        // the pattern and the write run on the writer thread. Errors are still written before the call returns.
+        static void init(bool async = YZ_LOG_ASYNC);
         static void changeFilePath(const std::string& path);
         static void update();
+        // Blocks until every message logged so far is written
+        static void flush();
         inline static std::shared_ptr<spdlog::logger>& getEventLogger() { return m_EngineLogger; }
 
+        // The text of a critical error, formatted the same way as the logged message
+        static std::string formatMessage(const std::string& message) { return message; }
+        static std::string formatMessage(const char* message) { return message; }
+        template <class... Args>
+        static std::string formatMessage(const char* format, const Args&... args) { return fmt::format(format, args...); }
+
     private:
         static std::shared_ptr<spdlog::logger> m_EngineLogger;
         static std::string m_FileOutputPath;
@@ -20,13 +53,36 @@ namespace Yare {
     };
 }
 
+// A single string is logged as it is. More arguments are formatted in place of {} in the first, e.g.
+// YZ_INFO("FPS: {}", fps), which saves building a string on hot paths.
+#if YZ_LOG_LEVEL <= YZ_LOG_LEVEL_TRACE
 #define YZ_TRACE(...)       ::Yare::Logger::getEventLogger()->trace(__VA_ARGS__)
+#else
+#define YZ_TRACE(...)       (void)0
+#endif
+#if YZ_LOG_LEVEL <= YZ_LOG_LEVEL_DEBUG
+#define YZ_DEBUG(...)       ::Yare::Logger::getEventLogger()->debug(__VA_ARGS__)
+#else
+#define YZ_DEBUG(...)       (void)0
+#endif
+#if YZ_LOG_LEVEL <= YZ_LOG_LEVEL_INFO
 #define YZ_INFO(...)        ::Yare::Logger::getEventLogger()->info(__VA_ARGS__)
+#else
+#define YZ_INFO(...)        (void)0
+#endif
+#if YZ_LOG_LEVEL <= YZ_LOG_LEVEL_WARN
 #define YZ_WARN(...)        ::Yare::Logger::getEventLogger()->warn(__VA_ARGS__)
+#else
+#define YZ_WARN(...)        (void)0
+#endif
+#if YZ_LOG_LEVEL <= YZ_LOG_LEVEL_ERROR
 #define YZ_ERROR(...)       ::Yare::Logger::getEventLogger()->error(__VA_ARGS__)
+#else
+#define YZ_ERROR(...)       (void)0
+#endif
 #define YZ_CRITICAL(...)    { \
                             ::Yare::Logger::getEventLogger()->critical(__VA_ARGS__); \
-                            throw std::runtime_error(__VA_ARGS__); \
+                            throw std::runtime_error(::Yare::Logger::formatMessage(__VA_ARGS__)); \
                             }
 
 #define STR(x)              (std::to_string(x))
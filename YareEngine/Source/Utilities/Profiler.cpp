@@ -0,0 +1,107 @@
+#include "Utilities/Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Yare::Utilities {
+
+    namespace {
+        std::mutex s_RingMutex;
+
+        // Pairs of counter and clock readings, the counter's rate is measured between them when exporting
+        const uint64_t s_StartTicks = Profiler::now();
+        const auto     s_StartTime = std::chrono::steady_clock::now();
+
+        std::string escapeJson(const char* text) {
+            std::string escaped;
+            for (; *text; text++) {
+                if (*text == '"' || *text == '\\') {
+                    escaped += '\\';
+                }
+                escaped += *text;
+            }
+            return escaped;
+        }
+    }
+
+    std::vector<std::unique_ptr<Profiler::ThreadRing>>& Profiler::getRings() {
+        static std::vector<std::unique_ptr<ThreadRing>> rings;
+        return rings;
+    }
+
+    Profiler::ThreadRing* Profiler::registerThread() {
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        auto& rings = getRings();
+        auto ring = std::make_unique<ThreadRing>();
+        ring->id = static_cast<uint32_t>(rings.size());
+        ring->name = "Thread " + std::to_string(ring->id);
+        s_ThreadRing = ring.get();
+        rings.push_back(std::move(ring));
+        return s_ThreadRing;
+    }
+
+    void Profiler::setThreadName(const std::string& name) {
+        auto ring = s_ThreadRing ? s_ThreadRing : registerThread();
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        ring->name = name;
+    }
+
+    bool Profiler::writeChromeTrace(const std::string& filePath) {
+        std::ofstream file(filePath);
+        if (!file) {
+            return false;
+        }
+
+        auto endTicks = now();
+        auto endTime = std::chrono::steady_clock::now();
+        double nanosecondsPerTick = 1.0;
+        if (endTicks > s_StartTicks) {
+            nanosecondsPerTick = std::chrono::duration<double, std::nano>(endTime - s_StartTime).count() /
+                                 static_cast<double>(endTicks - s_StartTicks);
+        }
+        auto toMicroseconds = [&](uint64_t ticks) {
+            return (static_cast<double>(ticks) - static_cast<double>(s_StartTicks)) * nanosecondsPerTick / 1000.0;
+        };
+
+        std::lock_guard<std::mutex> lock(s_RingMutex);
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]() -> const char* {
+            auto result = first ? "\n" : ",\n";
+            first = false;
+            return result;
+        };
+
+        std::vector<Zone> zones;
+        for (const auto& ring : getRings()) {
+            file << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->id
+                 << ",\"args\":{\"name\":\"" << escapeJson(ring->name.c_str()) << "\"}}";
+
+            // The owning thread may keep writing, zones it could have overwritten during the copy are dropped
+            auto written = ring->written.load(std::memory_order_acquire);
+            auto begin = written > RING_SIZE ? written - RING_SIZE : 0;
+            zones.clear();
+            for (auto index = begin; index < written; index++) {
+                zones.push_back(ring->zones[index & (RING_SIZE - 1)]);
+            }
+            auto writtenAfter = ring->written.load(std::memory_order_acquire);
+            auto overwritten = writtenAfter + 1 > RING_SIZE ? writtenAfter + 1 - RING_SIZE : 0;
+            auto skip = static_cast<size_t>(std::min<uint64_t>(overwritten > begin ? overwritten - begin : 0,
+                                                               zones.size()));
+
+            for (size_t i = skip; i < zones.size(); i++) {
+                const auto& zone = zones[i];
+                auto start = toMicroseconds(zone.start);
+                file << separator() << "{\"name\":\"" << escapeJson(zone.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                     << ring->id << ",\"ts\":" << start << ",\"dur\":" << toMicroseconds(zone.end) - start << "}";
+            }
+        }
+        file << "\n]}\n";
+        return static_cast<bool>(file);
+    }
+}
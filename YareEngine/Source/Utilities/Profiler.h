@@ -0,0 +1,106 @@
+#ifndef YARE_PROFILER_H
+#define YARE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Zones are recorded in debug builds, release builds compile them out unless YARE_FORCE_PROFILING is set
+#ifndef YZ_ENABLE_PROFILING
+#ifdef NDEBUG
+#define YZ_ENABLE_PROFILING 0
+#else
+#define YZ_ENABLE_PROFILING 1
+#endif
+#endif
+
+namespace Yare::Utilities {
+
+    // Records named CPU zones into a ring per thread and exports them as a Chrome trace.
+    // Each ring only has its own thread writing to it, so recording a zone takes no lock.
+    // Once a ring is full the oldest zones are overwritten.
+    class Profiler {
+    public:
+        // Names must outlive the profiler, string literals or renderer names
+        struct Zone {
+            const char* name;
+            uint64_t    start;
+            uint64_t    end;
+        };
+
+        static constexpr uint32_t RING_SIZE = 1 << 16;
+
+        // Timestamp counter where available, converted to time when exported
+        static uint64_t now() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        static void record(const char* name, uint64_t start, uint64_t end) {
+            auto ring = s_ThreadRing ? s_ThreadRing : registerThread();
+            auto index = ring->written.load(std::memory_order_relaxed);
+            ring->zones[index & (RING_SIZE - 1)] = {name, start, end};
+            ring->written.store(index + 1, std::memory_order_release);
+        }
+
+        // Shown as the thread's name in the trace
+        static void setThreadName(const std::string& name);
+
+        // Writes the zones still held by every ring in the Chrome trace_event format, which Perfetto and
+        // chrome://tracing open. Zones that are overwritten while exporting are left out.
+        static bool writeChromeTrace(const std::string& filePath);
+
+    private:
+        struct ThreadRing {
+            std::string           name;
+            uint32_t              id;
+            std::atomic<uint64_t> written{0};
+            Zone                  zones[RING_SIZE];
+        };
+
+        static ThreadRing* registerThread();
+        // Rings outlive their threads, workers that have exited still show up in the trace
+        static std::vector<std::unique_ptr<ThreadRing>>& getRings();
+
+        inline static thread_local ThreadRing* s_ThreadRing = nullptr;
+    };
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name) : m_Name(name), m_Start(Profiler::now()) {}
+        ~ProfileScope() { Profiler::record(m_Name, m_Start, Profiler::now()); }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_Name;
+        uint64_t    m_Start;
+    };
+}
+
+#if YZ_ENABLE_PROFILING
+#define YZ_PROFILE_CONCAT_INNER(a, b) a##b
+#define YZ_PROFILE_CONCAT(a, b)       YZ_PROFILE_CONCAT_INNER(a, b)
+#define YZ_PROFILE_SCOPE(name)        ::Yare::Utilities::ProfileScope YZ_PROFILE_CONCAT(yzProfileScope, __LINE__)(name)
+#define YZ_PROFILE_FUNCTION()         YZ_PROFILE_SCOPE(__func__)
+#define YZ_PROFILE_THREAD(name)       ::Yare::Utilities::Profiler::setThreadName(name)
+#else
+#define YZ_PROFILE_SCOPE(name)
+#define YZ_PROFILE_FUNCTION()
+#define YZ_PROFILE_THREAD(name)
+#endif
+
+#endif // YARE_PROFILER_H